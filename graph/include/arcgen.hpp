@@ -0,0 +1,67 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#ifndef __ARCGEN_HPP_INCLUDED
+#define __ARCGEN_HPP_INCLUDED
+
+#include <functional>  // std::function
+#include "glob.hpp"    // mfloat, muint, muvec
+#include "object.hpp"  // Object
+
+typedef std::function <void (const Object&)> ArcVisit;  // takes one arc
+
+// Arcs of a generated graph, produced on demand. The sinks are split into
+// blocks of about 2^20 possible arcs (the block size depends only on the
+// number of sources), and every block draws its sampled arcs and its costs
+// from its own random streams, derived from the seed and the block number. A
+// block can thus be generated by any thread, any number of times, always with
+// the same result. Each block takes its share of the sample in proportion to
+// the arcs it has available, so its arc count does not depend on the others.
+class ArcGen {
+public:
+  ArcGen (const muint dsz, const muint ssz, const muint cmx, const bool rv,
+          const muvec& EXC, const muint asz, const muint seed);
+  muint Arcs() const { return pFST.back(); };
+  void  Block (const muint b, const ArcVisit& v) const;
+  muint Blocks() const { return pCNT.size(); };
+  muint First (const muint b) const { return pFST[b]; };
+  muint Sinks (const muint b) const;
+private:
+  muvec  pCNT;  // sampled arcs of each block
+  muvec  pEXC;  // positions i * ssz + j of the connecting arcs, sorted
+  muvec  pFST;  // first arc of each block, then the total number of arcs
+  muvec  pTB;   // first connecting arc of each block
+  muint  pBSZ;  // sinks per block
+  muint  pCMX;  // maximum arc cost
+  muint  pDSZ;  // number of sinks
+  bool   pRV;   // real-valued costs?
+  muint  pSD;   // seed of the graph
+  muint  pSSZ;  // number of sources
+};
+
+#endif // __ARCGEN_HPP_INCLUDED
@@ -0,0 +1,78 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#ifndef __GBIN_HPP_INCLUDED
+#define __GBIN_HPP_INCLUDED
+
+#include <cstdint>   // std::uint32_t, std::uint64_t
+#include <cstring>   // std::memcmp
+
+// Binary graph file, version 1. A 64-byte header is followed by five arrays,
+// each starting on an 8-byte boundary and stored in native byte order:
+//   DWT : nrow demand (bidder) weights       - double
+//   SWT : ncol supply (lot) weights          - double
+//   OFS : nrow + 1 CSR row offsets           - uint64
+//   CST : narc arc costs, grouped by row     - double
+//   LOT : narc supply index of each arc      - uint32
+// Rows are the demand side seen by the solvers, i.e. the sinks, or the sources
+// when a graph has more sources than sinks.
+
+const char          GBIN_MAGIC[8] = { 'A', 'U', 'C', 'T', 'C', 'S', 'R', '\0' };
+const std::uint32_t GBIN_ORDER    = 0x01020304;
+const std::uint32_t GBIN_VERSION  = 1;
+
+struct GBinHead {
+  char          magic[8];  // GBIN_MAGIC
+  std::uint32_t version;   // GBIN_VERSION
+  std::uint32_t order;     // GBIN_ORDER, as written by the producing machine
+  std::uint64_t seed;      // random seed of the graph
+  std::uint64_t nrow;      // number of demand (bidder) vertices
+  std::uint64_t ncol;      // number of supply (lot) vertices
+  std::uint64_t narc;      // number of arcs
+  std::uint64_t rsv[2];    // reserved, zero
+};
+
+inline bool GBinCheck (const GBinHead& H) {
+  return (   (std::memcmp (H.magic, GBIN_MAGIC, 8) == 0)
+          && (H.version == GBIN_VERSION) && (H.order == GBIN_ORDER));
+}
+
+inline std::uint64_t GBinSize (const GBinHead& H) {
+  return (  sizeof (GBinHead) + 8 * (H.nrow + H.ncol + H.nrow + 1 + H.narc)
+          + 4 * H.narc);
+}
+
+// true if the arrays H describes fit in a file of sz bytes; every count is
+// first bounded by sz / 8, so that GBinSize cannot wrap around for a corrupt
+// header
+inline bool GBinFits (const GBinHead& H, const std::uint64_t sz) {
+  return (   (H.nrow <= sz / 8) && (H.ncol <= sz / 8) && (H.narc <= sz / 8)
+          && (GBinSize (H) <= sz));
+}
+
+#endif // __GBIN_HPP_INCLUDED
@@ -0,0 +1,54 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#ifndef __SAMPLER_HPP_INCLUDED
+#define __SAMPLER_HPP_INCLUDED
+
+#include <random>    // std::mt19937_64
+#include "glob.hpp"  // mfloat, muint
+
+// Sequential random sampling (Vitter's method D): draws n distinct positions
+// from 0, ..., N-1, uniformly among all such sets, and returns them one at a
+// time in increasing order. The expected work is proportional to n, whatever
+// the size of N, and no positions are stored.
+class Sampler {
+public:
+  Sampler (const muint N, const muint n, const muint seed);
+  muint Left() const { return pn; };
+  bool  Next (muint& x);
+private:
+  muint  SkipA ();
+  muint  SkipD ();
+  mfloat Uniform ();
+  std::mt19937_64 pGEN;
+  muint pN;    // positions not yet passed
+  muint pn;    // positions still to draw
+  muint pNXT;  // first position not yet passed
+};
+
+#endif // __SAMPLER_HPP_INCLUDED
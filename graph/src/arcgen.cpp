@@ -0,0 +1,123 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#include <algorithm>    // std::lower_bound, std::min
+#include <cstdint>      // std::uint32_t
+#include <random>       // std::mt19937_64, std::seed_seq,
+                        //   std::uniform_int_distribution,
+                        //   std::uniform_real_distribution
+#include "arcgen.hpp"
+#include "sampler.hpp"  // Sampler
+
+/** --- Standard Constructor ---------------------------------------------------
+ * blocks hold about 2^20 possible arcs; block b takes
+ *   floor (m * A(b+1) / A) - floor (m * A(b) / A)
+ * of the m sampled arcs, where A(b) counts the arcs available (not connecting
+ * arcs) before block b, and A is their total
+ **/
+ArcGen::ArcGen (const muint dsz, const muint ssz, const muint cmx,
+                const bool rv, const muvec& EXC, const muint asz,
+                const muint seed)
+  : pEXC (EXC), pBSZ (1), pCMX (cmx), pDSZ (dsz), pRV (rv), pSD (seed),
+    pSSZ (ssz) {
+  __extension__ typedef unsigned __int128 mu128;
+  if (ssz < (muint (1) << 20)) {
+    pBSZ = (muint (1) << 20) / ssz;
+  }
+  muint nb = (dsz + pBSZ - 1) / pBSZ;
+  muint av = dsz * ssz - EXC.size();  // arcs available for the sample
+  muint m  = asz - EXC.size();        // arcs to sample
+  muint ca = 0;                       // arcs available before the block
+  muint cs = 0;                       // arcs sampled before the block
+  pCNT.resize (nb);
+  pTB.resize (nb + 1);
+  pFST.resize (nb + 1);
+  pFST[0] = 0;
+  for (muint b = 0; b <= nb; b++) {
+    muint e = std::min (b * pBSZ, dsz) * ssz;  // first position of block b
+    pTB[b] = muint (std::lower_bound (pEXC.begin(), pEXC.end(), e)
+                    - pEXC.begin());
+  }
+  for (muint b = 0; b < nb; b++) {
+    muint np = (std::min ((b + 1) * pBSZ, dsz) - b * pBSZ) * ssz;
+    ca += np - (pTB[b+1] - pTB[b]);
+    muint s = (av == 0) ? 0 : muint (mu128 (m) * mu128 (ca) / mu128 (av));
+    pCNT[b]   = s - cs;
+    pFST[b+1] = pFST[b] + pCNT[b] + pTB[b+1] - pTB[b];
+    cs = s;
+  }
+}
+
+/** --- Block ------------------------------------------------------------------
+ * visits the arcs of block b in order (by sink, then by source), drawing each
+ * cost as the arc is visited
+ **/
+void ArcGen::Block (const muint b, const ArcVisit& v) const {
+  std::seed_seq ss { muint (pSD & 0xFFFFFFFF), muint (pSD >> 32),
+                     muint (b & 0xFFFFFFFF), muint (b >> 32) };
+  std::uint32_t sd[4];
+  ss.generate (sd, sd + 4);
+  muint  base = b * pBSZ * pSSZ;            // first position of the block
+  muint  np   = Sinks (b) * pSSZ;           // positions in the block
+  muint  t0   = pTB[b];                     // first connecting arc
+  Sampler smp (np - (pTB[b+1] - t0), pCNT[b],
+               (muint (sd[0]) << 32) | muint (sd[1]));
+  std::mt19937_64 cgen ((muint (sd[2]) << 32) | muint (sd[3]));
+  std::uniform_int_distribution <muint>  dsci (1, pCMX);
+  std::uniform_real_distribution<mfloat> dscr (1.0, mfloat (pCMX));
+  muint q;       // rank of the next sampled arc among the available arcs
+  muint t = t0;  // connecting arcs before the next sampled arc
+  muint u = t0;  // next connecting arc
+  bool  more = smp.Next (q);
+  while ((more) || (u < pTB[b+1])) {
+    muint x;  // position of the arc
+    while ((more) && (t < pTB[b+1]) && (pEXC[t] - base <= q + t - t0)) {
+      ++t;
+    }
+    if ((more) && ((u == pTB[b+1]) || (base + q + t - t0 < pEXC[u]))) {
+      x = base + q + t - t0;
+      more = smp.Next (q);
+    } else {
+      x = pEXC[u++];
+    }
+    if (pRV) {
+      v (Object (dscr (cgen), x / pSSZ, x % pSSZ));
+    } else {
+      v (Object (mfloat (dsci (cgen)), x / pSSZ, x % pSSZ));
+    }
+  }
+}
+
+/** --- Sinks ------------------------------------------------------------------
+ * number of sinks in block b
+ **/
+muint ArcGen::Sinks (const muint b) const {
+  return std::min ((b + 1) * pBSZ, pDSZ) - b * pBSZ;
+}
+
+/// ----------------------------------------------------------------------------
@@ -26,10 +26,11 @@ those of the author and do not necessarily reflect the views of the National
 Science Foundation.
 ---------------------------------------------------------------------------- **/
 
-#include <algorithm>   // std::find
-#include <cmath>       // std::floor, std::round
+#include <algorithm>   // std::find, std::max, std::min, std::sort, std::swap
+#include <cmath>       // std::floor, std::fma, std::fmod, std::round
 #include <cstdlib>     // exit, EXIT_FAILURE
 #include <cstdio>      // std::sprintf
+#include <cstring>     // std::memcpy, std::memset
 #include <fstream>     // std::ofstream
 #include <iostream>    // std::cout, std::endl, std::ios::out, std::ios::trunc
 #include <random>      // std::mt19937_64, std::uniform_int_distribution,
@@ -40,26 +41,39 @@ Science Foundation.
 #include <vector>      // std::vector
 #include "glob.hpp"    // mfloat, mfvec, muint
 #include "object.hpp"  // objlist, voblist
+#include "gbin.hpp"    // GBinHead, GBIN_MAGIC, GBIN_ORDER, GBIN_VERSION
+#include "arcgen.hpp"  // ArcGen, ArcVisit
+#include "pool.hpp"    // Pool
 
 mfloat gEPS = std::sqrt(std::numeric_limits<mfloat>::epsilon());
 
+void Connect (const muint dsz, const muint ssz, const muint wmx, const bool rv,
+              std::mt19937_64& gen, objlist& TRE);
 char* GetOption (char ** begin, char ** end, const std::string & option);
 char** GetOptionList (char ** begin, char ** end, const std::string & option,
                       const muint cnt);
 bool OptionExists (char** begin, char** end, const std::string& option);
+void Shuffle (muvec& P, std::mt19937_64& gen);
 void Split (const std::string &s, std::vector<std::string> &elms);
 void Split (const std::string &s, char dlm, std::vector<std::string> &elms);
 muint ReadFile (const char* fname, muint& dsz, muint& ssz, muint& asz,
                 muint& wmx, bool& rv);
+mfloat TextValue (const mfloat x);
+int  WriteBinary (const char* fname, const muint seed, const mfvec& DWT,
+                  const mfvec& SWT, const ArcGen& G, Pool& pool);
 int  WriteFile (const char* fname, const muint seed, const mfvec& DWT,
-                const mfvec& SWT, const objlist& ARX);
+                const mfvec& SWT, const ArcGen& G, Pool& pool);
 
 /** --- main -------------------------------------------------------------------
  * program flags:
  *   -a # : number of arcs [integer # >= sinks + sources - 1]
+ *   -b S : save graph to binary data file S (text is then saved only if -s
+ *            is also given)
  *   -c # : maximum cost [positive integer # >= 1]
  *   -d # : randomize using seed # [default: time-based seed]
  *   -i   : integer-valued graph
+ *   -j # : number of threads [positive integer; the graph does not depend
+ *            on it]
  *   -k # : number of sinks [positive integer]
  *   -l S : load graph characteristics from data file S
  *   -p # : percentage of arcs [real number 0 < # < 1]
@@ -67,6 +81,7 @@ int  WriteFile (const char* fname, const muint seed, const mfvec& DWT,
  *   -s S : save graph to data file S
  *   -w # : maximum weight [positive integer # >= 1]
  *   -x   : return initial time-based seed and exit, ignoring other flags
+ *   -z   : sparse mode (accepted for compatibility; always on)
  **/
 
 int main (int argc, char *argv[])
@@ -79,6 +94,7 @@ int main (int argc, char *argv[])
   int     scc = 0;     // success / error output
   muint   seed = 0;    // random seed
   char    str[255];    // display string
+  muint   thr = 1;     // number of threads
   muint   wmx = 100;   // maximum vertex weight
   // Implement option flags
   char* lname = GetOption(argv, argv + argc, "-l");
@@ -147,175 +163,49 @@ int main (int argc, char *argv[])
     if (OptionExists(argv, argv+argc, "-i")) {
       rv = false;
     }
+    char* jstr = GetOption(argv, argv + argc, "-j");
+    if (jstr != 0) {
+      if (std::strtol (jstr, nullptr, 0) > 0) {
+        thr = std::strtoul (jstr, nullptr, 0);
+      }
+    }
+    Pool pool (thr);
     char* fname = GetOption(argv, argv + argc, "-s");
-    muint   act = 0;         // arc count
-    objlist ARX;             // arc list
-    muint   k;               // positive vertex index
-    muint   l;               // negative vertex index
-    bool    ps;              // positive vertex next?
+    char* bname = GetOption(argv, argv + argc, "-b");
+    objlist TRE;             // connecting arcs, sorted by sink
+    muvec   EXC;             // positions i * ssz + j of the connecting arcs
     mfvec   SWT (ssz, 0.0);  // negative vertex weights
     mfvec   DWT (dsz, 0.0);  // positive vertex weights
-    // INITIALIZE RANDOM GENERATORS
+    // INITIALIZE RANDOM GENERATOR
     std::mt19937_64 gen (seed);
-    std::uniform_int_distribution <muint>  dsci (1, cmx);
-    std::uniform_real_distribution<mfloat> dscr (1.0, mfloat (cmx));
-    std::uniform_int_distribution <muint>  dstd (0, dsz - 1);
-    std::uniform_int_distribution <muint>  dsti (1, wmx);
-    std::uniform_int_distribution <muint>  dstp;
-    std::uniform_real_distribution<mfloat> dstr (1.0, mfloat (wmx));
-    std::uniform_int_distribution <muint>  dsts (0, ssz - 1);
     std::sprintf (str, " * seed = %lu", seed);
     std::cout << str << std::endl;
-    // CONSTRUCT FULL ARC ARRAY WITH ALL EDGES HAVING ZERO WEIGHT
-    ARX = objlist (dsz * ssz);
-    for (muint i = 0; i < dsz; i++) {
-      for (muint j = 0; j < ssz; j++) {
-        ARX[i * ssz + j] = Object (0.0, i, j);
-      }
-    }
-    std::cout << "Empty arc array constructed" << std::endl;
-    // ENSURE AT LEAST ONE POSITIVE WEIGHT EDGE FOR EACH SINK
-    for (muint it = 0; it < dsz; it++) {
-      if (rv) {
-        ARX[it * ssz + dsts (gen)].c = dstr (gen);
-      } else {
-        ARX[it * ssz + dsts (gen)].c = mfloat (dsti (gen));
-      }
-      ++act;
-    }
-    std::sprintf (str, "Sinks connected: %lu positive arcs", act);
-    std::cout << str << std::endl;
-    // ENSURE AT LEAST ONE POSITIVE WEIGHT EDGE FOR EACH SOURCE
-    for (muint it = 0; it < ssz; it++) {
-      k = 0;
-      while ((k < dsz) && (ARX[k * ssz + it].c < gEPS)) {
-        ++k;
-      }
-      if (k == dsz) {
-        if (rv) {
-          ARX[dstd (gen) * ssz + it].c = dstr (gen);
-        } else {
-          ARX[dstd (gen) * ssz + it].c = mfloat (dsti (gen));
-        }
-        ++act;
-      }
-    }
-    std::sprintf (str, "Sources connected: %lu positive arcs", act);
-    std::cout << str << std::endl;
-    // ENSURE GRAPH IS CONNECTED, ADDING WEIGHTED EDGES AS NECESSARY
-    muvec pth (1, 0);     // point thread
-    muint pam = dsz - 1;  // positive amount of unassigned vertices
-    muint nam = ssz;      // negative amount of unassigned vertices
-    std::vector <bool> PNV (dsz, false); // positive vertex not available?
-    std::vector <bool> NNV (ssz, false); // negative vertex not available?
-    PNV[0] = true;
-    do {
-      k = 0;
-      if (pth.size() % 2 == 0) {
-        while ((k < dsz) && (PNV[k] || (ARX[k * ssz + pth.back()].c < gEPS))) {
-          ++k;
-        }
-        if (k < ssz) {
-          PNV[k] = true;
-          --pam;
-          pth.push_back (k);
-        } else {
-          pth.pop_back();
-        }
-      } else {
-        while ((k < ssz) && (NNV[k] || (ARX[pth.back() * ssz + k].c < gEPS))) {
-          ++k;
-        }
-        if (k < ssz) {
-          NNV[k] = true;
-          --nam;
-          pth.push_back (k);
-        } else {
-          pth.pop_back();
-        }
-      }
-      if ((pth.size() == 0) && ((pam > 0) || (nam > 0))) {
-        if ((pam > 0) && (nam > 0)) {
-          if (nam == ssz) {
-            ps = false;
-          } else {
-            ps = (dsti (gen) % 2 == 0);
-          }
-        } else if (pam > 0) {
-          ps = true;
-        } else {
-          ps = false;
-        }
-        if (ps && (nam == ssz)) {
-          ps = false;
-        }
-        if (ps) {
-          do {
-            k = dstd (gen);
-          } while (PNV[k]);
-          do {
-            l = dsts (gen);
-          } while (!NNV[l]);
-          --pam;
-        } else {
-          do {
-            k = dstd (gen);
-          } while (!PNV[k]);
-          do {
-            l = dsts (gen);
-          } while (NNV[l]);
-        }
-        if (rv) {
-          ARX[k * ssz + l].c = dstr (gen);
-        } else {
-          ARX[k * ssz + l].c = mfloat (dsti (gen));
-        }
-        ++act;
-        PNV[k] = true;
-        pth.push_back (k);
-      }
-    } while ((pam > 0) || (nam > 0));
-    std::sprintf (str, "Graph connected: %lu positive arcs", act);
+    // CONNECT THE GRAPH, STORING ONLY THE CONNECTING ARCS
+    Connect (dsz, ssz, wmx, rv, gen, TRE);
+    std::sprintf (str, "Graph connected: %lu positive arcs", TRE.size());
     std::cout << str << std::endl;
     // TOTAL UP WEIGHTS FOR DWT AND SWT
-    for (muint i = 0; i < dsz; i++) {
-      for (muint j = 0; j < ssz; j++) {
-        DWT[i] += ARX[i * ssz + j].c;
-        SWT[j] += ARX[i * ssz + j].c;
-      }
+    for (muint it = 0; it < TRE.size(); it++) {
+      DWT[TRE[it].i] += TRE[it].c;
+      SWT[TRE[it].j] += TRE[it].c;
+      EXC.push_back (TRE[it].i * ssz + TRE[it].j);
     }
     std::cout << "Vertex weights assigned" << std::endl;
-    // RANDOMLY REMOVE MEMBERS FROM ARX UNTIL ARX SIZE EQUALS ASZ
-    muint tst;
-    if (asz < act) {
-      asz = act;
-    }
-    act  = ARX.size();
-    while (ARX.size() > asz) {
-      --act;
-      dstp = std::uniform_int_distribution <muint>  (0, act);
-      do {
-        tst = dstp (gen);
-        if (ARX[tst].c < gEPS) {
-          ARX[tst] = ARX.back();
-          ARX.pop_back();
-        }
-      } while (ARX.size() > act);
-    }
-    std::sort (ARX.begin(), ARX.end(), [](const Object& a, const Object& b)
-      -> bool { return ((a.i < b.i) || ((a.i == b.i) && (a.j < b.j))); });
-    std::sprintf (str, "Graph pruned: %lu arcs remaining", asz);
+    // DRAW THE REMAINING ARCS FROM THE ARCS NOT YET USED
+    asz = std::min (std::max (asz, TRE.size()), dsz * ssz);
+    // THE SAMPLE AND THE COSTS ARE DRAWN AS THE ARCS ARE WRITTEN, BLOCK BY
+    // BLOCK, EACH BLOCK FROM ITS OWN GENERATORS
+    ArcGen G (dsz, ssz, cmx, rv, EXC, asz, gen ());
+    std::sprintf (str, "Graph sampled: %lu arcs", asz);
     std::cout << str << std::endl;
-    // ASSIGN COSTS TO REMAINING ARCS
-    for (muint it = 0; it < ARX.size(); it++) {
-      if (rv) {
-        ARX[it].c = dscr (gen);
-      } else {
-        ARX[it].c = mfloat (dsci (gen));
+    // WRITE GRAPH FILE
+    if (bname != 0) {
+      scc = WriteBinary (bname, seed, DWT, SWT, G, pool);
+      std::cout << "Binary graph file written" << std::endl;
+      if (fname == 0) {
+        return scc;
       }
     }
-    std::cout << "Arc costs assigned" << std::endl;
-    // WRITE GRAPH FILE
     if (fname == 0) {
       char dname[255];
       if (rv) {
@@ -325,15 +215,106 @@ int main (int argc, char *argv[])
         std::sprintf (dname, "I-%04lu-%04lu-%06lu-%02lu.txt",
                       ssz, dsz, asz, wmx);
       }
-      scc = WriteFile (dname, seed, DWT, SWT, ARX);
+      scc = WriteFile (dname, seed, DWT, SWT, G, pool);
     } else {
-      scc = WriteFile (fname, seed, DWT, SWT, ARX);
+      scc = WriteFile (fname, seed, DWT, SWT, G, pool);
     }
     std::cout << "Graph file written" << std::endl;
   }
   return scc;
 }
 
+/** --- Connect ----------------------------------------------------------------
+ * builds a connected set of weighted arcs that touches every vertex: each sink
+ * is joined to a random source, and each source left out to a random sink;
+ * the parts formed so far (kept as disjoint sets) are then taken in random
+ * order, and each is joined to a random earlier part by one more arc between
+ * random members of the two; TRE receives the arcs (a spanning forest that is
+ * a tree), sorted by sink and then by source
+ **/
+void Connect (const muint dsz, const muint ssz, const muint wmx, const bool rv,
+              std::mt19937_64& gen, objlist& TRE) {
+  std::uniform_int_distribution <muint>  dstc (0, 1);
+  std::uniform_int_distribution <muint>  dstd (0, dsz - 1);
+  std::uniform_int_distribution <muint>  dsti (1, wmx);
+  std::uniform_real_distribution<mfloat> dstr (1.0, mfloat (wmx));
+  std::uniform_int_distribution <muint>  dsts (0, ssz - 1);
+  muint nv = dsz + ssz;  // vertices: sinks first, then sources
+  muvec UF (nv);         // parent of each vertex in its disjoint set
+  muvec SZ (nv, 1);      // size of each set (valid for the set roots)
+  std::vector <bool> SC (ssz, false);  // source has an arc?
+  for (muint it = 0; it < nv; it++) {
+    UF[it] = it;
+  }
+  auto root = [&UF] (muint v) -> muint {
+    while (UF[v] != v) {
+      UF[v] = UF[UF[v]];
+      v = UF[v];
+    }
+    return v;
+  };
+  auto join = [&] (const muint i, const muint j) {
+    mfloat w = (rv) ? dstr (gen) : mfloat (dsti (gen));
+    TRE.push_back (Object (w, i, j));
+    SC[j] = true;
+    muint a = root (i);
+    muint b = root (dsz + j);
+    if (a != b) {
+      if (SZ[a] < SZ[b]) {
+        std::swap (a, b);
+      }
+      UF[b]  = a;
+      SZ[a] += SZ[b];
+    }
+  };
+  TRE.clear ();
+  // ENSURE AT LEAST ONE POSITIVE WEIGHT EDGE FOR EACH SINK
+  for (muint it = 0; it < dsz; it++) {
+    join (it, dsts (gen));
+  }
+  // ENSURE AT LEAST ONE POSITIVE WEIGHT EDGE FOR EACH SOURCE
+  for (muint it = 0; it < ssz; it++) {
+    if (!SC[it]) {
+      join (dstd (gen), it);
+    }
+  }
+  // PICK A RANDOM SINK AND A RANDOM SOURCE OF EACH PART: THE FIRST ONES IN
+  // SHUFFLED ORDER; THE PARTS ARE ORDERED BY THEIR SINKS
+  muvec PD (dsz);  // shuffled sinks
+  muvec PS (ssz);  // shuffled sources
+  Shuffle (PD, gen);
+  Shuffle (PS, gen);
+  muvec RD (nv, nv);  // chosen sink of each part (by root)
+  muvec RS (nv, nv);  // chosen source of each part (by root)
+  muvec PRT;          // roots of the parts, in random order
+  for (muint it = 0; it < dsz; it++) {
+    muint r = root (PD[it]);
+    if (RD[r] == nv) {
+      RD[r] = PD[it];
+      PRT.push_back (r);
+    }
+  }
+  for (muint it = 0; it < ssz; it++) {
+    muint r = root (dsz + PS[it]);
+    if (RS[r] == nv) {
+      RS[r] = PS[it];
+    }
+  }
+  // ENSURE GRAPH IS CONNECTED, JOINING EACH PART TO A RANDOM EARLIER PART
+  for (muint it = 1; it < PRT.size(); it++) {
+    std::uniform_int_distribution <muint> dstp (0, it - 1);
+    muint pt = PRT[dstp (gen)];
+    if (dstc (gen) == 0) {
+      join (RD[PRT[it]], RS[pt]);
+    } else {
+      join (RD[pt], RS[PRT[it]]);
+    }
+  }
+  std::sort (TRE.begin(), TRE.end(), [](const Object& a, const Object& b)
+    -> bool { return ((a.i < b.i) || ((a.i == b.i) && (a.j < b.j))); });
+  return;
+}
+
 /** --- GetOption --------------------------------------------------------------
  **/
 char* GetOption (char ** begin, char ** end, const std::string & option) {
@@ -367,6 +348,20 @@ bool OptionExists (char** begin, char** end, const std::string& option) {
   return std::find (begin, end, option) != end;
 }
 
+/** --- Shuffle ----------------------------------------------------------------
+ * fills P with 0, ..., P.size()-1 in random order (Fisher-Yates)
+ **/
+void Shuffle (muvec& P, std::mt19937_64& gen) {
+  for (muint it = 0; it < P.size(); it++) {
+    P[it] = it;
+  }
+  for (muint it = P.size(); it > 1; it--) {
+    std::uniform_int_distribution <muint> dstp (0, it - 1);
+    std::swap (P[it - 1], P[dstp (gen)]);
+  }
+  return;
+}
+
 /** --- Split ------------------------------------------------------------------
  **/
 void Split (const std::string &s, std::vector<std::string> &elms) {
@@ -463,10 +458,124 @@ muint ReadFile (const char* fname, muint& dsz, muint& ssz, muint& asz,
   return seed;
 }
 
+/** --- TextValue --------------------------------------------------------------
+ * returns x as it reads back from a text graph file
+ **/
+mfloat TextValue (const mfloat x) {
+  char str[255];
+  if (equal (x, std::floor (x))) {
+    return mfloat (muint (x));
+  }
+  // below 2^53 / 10^8, x * 10^8 is the rounded product p plus its exact error
+  // e, so rounding to 8 decimals (ties to even, as %.8f) needs no string
+  if ((x > 0.0) && (x < 9.0e7)) {
+    mfloat p = x * 1e8;
+    mfloat e = std::fma (x, 1e8, -p);
+    mfloat f = std::floor (p);
+    mfloat d = p - f;
+    if (   (d > 0.5)
+        || ((d >= 0.5) && ((e > 0.0)
+                           || ((e >= 0.0) && (std::fmod (f, 2.0) > 0.0))))) {
+      f += 1.0;
+    }
+    return f / 1e8;
+  }
+  std::sprintf (str, "%.8f", x);
+  return std::strtod (str, nullptr);
+}
+
+/** --- WriteBinary ------------------------------------------------------------
+ * uses the layout of <auction.out>: when there are more sources than sinks,
+ * the sources become the rows (bidders); values are rounded as in text files;
+ * the blocks of arcs are generated in parallel, straight into their places
+ **/
+int WriteBinary (const char* fname, const muint seed, const mfvec& DWT,
+                 const mfvec& SWT, const ArcGen& G, Pool& pool) {
+  int   err  = 1;
+  bool  rev  = (SWT.size() > DWT.size());
+  muint narc = G.Arcs();
+  const mfvec& RWT = (rev) ? SWT : DWT;  // row weights
+  const mfvec& CWT = (rev) ? DWT : SWT;  // column weights
+  std::vector <std::uint64_t> O (DWT.size() + 1, 0);  // row offsets
+  std::vector <std::uint32_t> L (narc);               // column ids
+  mfvec C (narc);                                     // costs
+  mfvec W;                                            // vertex weights
+  pool.Run (G.Blocks(), [&] (muint b) {
+    muint k = G.First (b);
+    G.Block (b, [&] (const Object& a) {
+      ++O[a.i + 1];
+      L[k]   = std::uint32_t (a.j);
+      C[k++] = TextValue (a.c);
+    });
+  });
+  for (muint it = 0; it < DWT.size(); it++) {
+    O[it+1] += O[it];
+  }
+  if (rev) {
+    std::vector <std::uint64_t> RO (SWT.size() + 1, 0);
+    std::vector <std::uint32_t> RL (narc);
+    mfvec RC (narc);
+    for (muint it = 0; it < narc; it++) {
+      ++RO[L[it] + 1];
+    }
+    for (muint it = 0; it < SWT.size(); it++) {
+      RO[it+1] += RO[it];
+    }
+    std::vector <std::uint64_t> pos (RO.begin(), RO.end() - 1);
+    for (muint i = 0; i < DWT.size(); i++) {
+      for (muint k = O[i]; k < O[i+1]; k++) {
+        RL[pos[L[k]]]   = std::uint32_t (i);
+        RC[pos[L[k]]++] = C[k];
+      }
+    }
+    O.swap (RO);
+    L.swap (RL);
+    C.swap (RC);
+  }
+  GBinHead H;
+  std::memset (&H, 0, sizeof (GBinHead));
+  std::memcpy (H.magic, GBIN_MAGIC, sizeof (GBIN_MAGIC));
+  H.version = GBIN_VERSION;
+  H.order   = GBIN_ORDER;
+  H.seed    = seed;
+  H.nrow    = RWT.size();
+  H.ncol    = CWT.size();
+  H.narc    = narc;
+  std::ofstream f (fname, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (f.is_open()) {
+    f.write (reinterpret_cast <const char*> (&H), sizeof (GBinHead));
+    W.resize (RWT.size());
+    for (muint it = 0; it < RWT.size(); it++) {
+      W[it] = TextValue (RWT[it]);
+    }
+    f.write (reinterpret_cast <const char*> (W.data()),
+             std::streamsize (W.size() * sizeof (mfloat)));
+    W.resize (CWT.size());
+    for (muint it = 0; it < CWT.size(); it++) {
+      W[it] = TextValue (CWT[it]);
+    }
+    f.write (reinterpret_cast <const char*> (W.data()),
+             std::streamsize (W.size() * sizeof (mfloat)));
+    f.write (reinterpret_cast <const char*> (O.data()),
+             std::streamsize (O.size() * sizeof (std::uint64_t)));
+    f.write (reinterpret_cast <const char*> (C.data()),
+             std::streamsize (C.size() * sizeof (mfloat)));
+    f.write (reinterpret_cast <const char*> (L.data()),
+             std::streamsize (L.size() * sizeof (std::uint32_t)));
+    if (f.good()) {
+      err = 0;
+    }
+    f.close();
+  }
+  return err;
+}
+
 /** --- WriteFile --------------------------------------------------------------
+ * the blocks of arcs are formatted in parallel, a few per thread at a time,
+ * and written in order
  **/
 int WriteFile (const char* fname, const muint seed, const mfvec& DWT,
-               const mfvec& SWT, const objlist& ARX) {
+               const mfvec& SWT, const ArcGen& G, Pool& pool) {
   int    err = 0;
   mfloat twt = 0.0;
   char  str[255];
@@ -480,10 +589,10 @@ int WriteFile (const char* fname, const muint seed, const mfvec& DWT,
                   DWT.size(), SWT.size());
     f << str << std::endl;
     if (equal (twt, std::floor (twt))) {
-      std::sprintf (str, " %lu ARCS AND %lu TOTAL WEIGHT", ARX.size(),
+      std::sprintf (str, " %lu ARCS AND %lu TOTAL WEIGHT", G.Arcs(),
                     muint (twt));
     } else {
-      std::sprintf (str, " %lu ARCS AND %.8f TOTAL WEIGHT", ARX.size(),
+      std::sprintf (str, " %lu ARCS AND %.8f TOTAL WEIGHT", G.Arcs(),
                     twt);
     }
     f << str << std::endl;
@@ -497,16 +606,29 @@ int WriteFile (const char* fname, const muint seed, const mfvec& DWT,
       f << str << std::endl;
     }
     f << "ARCS" << std::endl;
-    for (muint it = 0; it < ARX.size(); it++) {
-      if (equal (ARX[it].c, std::floor (ARX[it].c))) {
-        std::sprintf (str, " %lu %lu %lu %lu",
-                      ARX[it].i + 1, ARX[it].j + DWT.size() + 1,
-                      muint (ARX[it].c), muint (0));
-      } else {
-        std::sprintf (str, " %lu %lu %.8f %lu", ARX[it].i + 1,
-          ARX[it].j + DWT.size() + 1, ARX[it].c, muint (0));
+    muint nb = G.Blocks();
+    muint bt = 2 * pool.Size();          // blocks per batch
+    std::vector <std::string> BUF (bt);  // text of each block in the batch
+    for (muint b0 = 0; b0 < nb; b0 += bt) {
+      muint n = std::min (bt, nb - b0);
+      pool.Run (n, [&] (muint k) {
+        char ln[255];
+        std::string& B = BUF[k];
+        B.clear ();
+        G.Block (b0 + k, [&] (const Object& a) {
+          if (equal (a.c, std::floor (a.c))) {
+            std::sprintf (ln, " %lu %lu %lu %lu\n", a.i + 1,
+              a.j + DWT.size() + 1, muint (a.c), muint (0));
+          } else {
+            std::sprintf (ln, " %lu %lu %.8f %lu\n", a.i + 1,
+              a.j + DWT.size() + 1, a.c, muint (0));
+          }
+          B.append (ln);
+        });
+      });
+      for (muint k = 0; k < n; k++) {
+        f.write (BUF[k].data(), std::streamsize (BUF[k].size()));
       }
-      f << str << std::endl;
     }
     f << "SUPPLY" << std::endl;
     for (muint it = 0; it < SWT.size(); it++) {
@@ -0,0 +1,138 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#include <cmath>        // std::exp, std::log
+#include "sampler.hpp"
+
+/** --- Standard Constructor ---------------------------------------------------
+ **/
+Sampler::Sampler (const muint N, const muint n, const muint seed)
+  : pGEN (seed), pN (N), pn ((n < N) ? n : N), pNXT (0) { }
+
+/** --- Next -------------------------------------------------------------------
+ * stores the next drawn position in x; returns false once all n are drawn
+ **/
+bool Sampler::Next (muint& x) {
+  muint S;  // positions skipped before the next draw
+  if (pn == 0) {
+    return false;
+  }
+  if (pn == 1) {
+    std::uniform_int_distribution <muint> dstp (0, pN - 1);
+    S = dstp (pGEN);
+  } else if (13 * pn >= pN) {
+    S = SkipA ();
+  } else {
+    S = SkipD ();
+  }
+  x     = pNXT + S;
+  pNXT  = x + 1;
+  pN   -= S + 1;
+  --pn;
+  return true;
+}
+
+/** --- SkipA ------------------------------------------------------------------
+ * method A: inverts the skip distribution directly; used when n is a large
+ * share of N, where it takes O(N / n) steps per draw
+ **/
+muint Sampler::SkipA () {
+  muint  S    = 0;
+  mfloat top  = mfloat (pN - pn);
+  mfloat Nr   = mfloat (pN);
+  mfloat V    = Uniform ();
+  mfloat quot = top / Nr;
+  while (quot > V) {
+    ++S;
+    top  -= 1.0;
+    Nr   -= 1.0;
+    quot  = quot * top / Nr;
+  }
+  return S;
+}
+
+/** --- SkipD ------------------------------------------------------------------
+ * method D: draws the skip by rejection from a continuous envelope, in O(1)
+ * expected time
+ **/
+muint Sampler::SkipD () {
+  muint  S;
+  mfloat X, y1, y2, top, bottom;
+  mfloat Nr     = mfloat (pN);
+  mfloat nr     = mfloat (pn);
+  mfloat ninv   = 1.0 / nr;
+  mfloat nm1inv = 1.0 / (nr - 1.0);
+  muint  qu1    = pN - pn + 1;
+  mfloat qu1r   = mfloat (qu1);
+  mfloat Vp     = std::exp (std::log (Uniform ()) * ninv);
+  while (true) {
+    while (true) {
+      X = Nr * (1.0 - Vp);
+      S = muint (X);
+      if (S < qu1) {
+        break;
+      }
+      Vp = std::exp (std::log (Uniform ()) * ninv);
+    }
+    y1 = std::exp (std::log (Uniform () * Nr / qu1r) * nm1inv);
+    Vp = y1 * (1.0 - X / Nr) * (qu1r / (qu1r - mfloat (S)));
+    if (Vp <= 1.0) {
+      break;
+    }
+    muint limit;
+    y2  = 1.0;
+    top = Nr - 1.0;
+    if (pn - 1 > S) {
+      bottom = Nr - nr;
+      limit  = pN - S;
+    } else {
+      bottom = Nr - mfloat (S) - 1.0;
+      limit  = qu1;
+    }
+    for (muint t = pN - 1; t >= limit; t--) {
+      y2 = (y2 * top) / bottom;
+      top    -= 1.0;
+      bottom -= 1.0;
+    }
+    if (Nr / (Nr - X) >= y1 * std::exp (std::log (y2) * nm1inv)) {
+      break;
+    }
+    Vp = std::exp (std::log (Uniform ()) * ninv);
+  }
+  return S;
+}
+
+/** --- Uniform ----------------------------------------------------------------
+ * uniform value in (0, 1]
+ **/
+mfloat Sampler::Uniform () {
+  std::uniform_real_distribution <mfloat> dstu (0.0, 1.0);
+  return 1.0 - dstu (pGEN);
+}
+
+/// ----------------------------------------------------------------------------
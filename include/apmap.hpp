@@ -29,32 +29,62 @@ Science Foundation.
 #ifndef __APMAP_HPP_INCLUDED
 #define __APMAP_HPP_INCLUDED
 
-#include <algorithm>   // std::sort
-#include <cmath>       // std::floor
-#include <iostream>    // std::cout, std::endl, std::sprintf
-#include <vector>      // std::vector
-#include "glob.hpp"    // mfloat, mfvec, mint, muint
-#include "object.hpp"  // objlist, voblist
-#include "apbid.hpp"   // APbidlist
+#include <algorithm>     // std::inplace_merge, std::min, std::remove_if,
+                         //   std::sort, std::unique
+#include <atomic>        // std::atomic
+#include <cmath>         // std::floor
+#include <chrono>        // std::chrono::duration,
+                         //   std::chrono::high_resolution_clock::now
+#include <iostream>      // std::cout, std::endl, std::sprintf
+#include <numeric>       // std::accumulate
+#include <thread>        // std::this_thread::yield
+#include <vector>        // std::vector
+#include "glob.hpp"      // gASY, mbvec, mfloat, mfvec, mint, muint, muvec
+#include "object.hpp"    // objlist
+#include "arcset.hpp"    // ArcSet
+#include "arcindex.hpp"  // ArcIndex
+#include "pool.hpp"      // Pool, poolptr
+#include "schedule.hpp"  // Schedule
+#include "apbid.hpp"     // APbidlist
 
 class APmap {
 public:
-  APmap() : pEPS (1.0), pGCD (1), pMN (1.0), pSTP (0.25) { };
-  APmap (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+  APmap() : pEPS (1.0), pGCD (1), pNB (0), pPS (0.0), pSNE (1.0) { };
+  APmap (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
          const mfloat MX, const mfloat MN, const mfloat ST);
   void Solve (objlist& T, mfvec& PR);
+  void Warm (const objlist& T, const mfvec& PR);
 private:
+  muvec      pACT;  // bidders that may bid, in order
+  ArcIndex   pAIX;  // lookup of the arcs by bidder class and lot
+  ArcSet     pARC;  // arcs of the bidders
   APbidlist  pBDR;  // vector of bidders
   objlist    pBID;  // vector of current bids
+  mbvec      pCHG;  // lots taken in the current iteration
   mfloat     pEPS;  // current epsilon value
   mint       pGCD;  // gcd of weights
-  mfloat     pMN;   // minimum epsilon value
+  objlist    pLP;   // lowest price of each lot, and its unit lot
+  muint      pNB;   // number of bids made
+  poolptr    pPOL;  // threads of the bid stage
   objlist    pPR;   // vector of prices
-  mfloat     pSTP;  // epsilon step size
+  mfloat     pPS;   // sum of the prices at the end of the last phase
+  Schedule   pSCH;  // epsilon schedule
+  mfvec      pSLK;  // slack of the holder of each unit lot
+  mfloat     pSNE;  // epsilon of the last phase, kept for a time budget
+  objlist    pSNP;  // prices after the last phase, kept for a time budget
+  muvec      pUNT;  // first unit lot of each lot, then the number of units
+  bool Async();
   void Auction();
   mint gcd (const mint a, const mint b) const;
-  void Round();
-  void UpdateClaims();
+  void Low (const muint j);
+  void Lows();
+  void Measure (const muint nb);
+  mfloat Net (const muint n, const muint u) const;
+  void Restore();
+  void Retain();
+  bool Round();
+  void Slack (muvec& hd, mfvec& bs);
+  void UpdateClaims (const muint na);
 };
 
 #endif // __APMAP_HPP_INCLUDED
@@ -0,0 +1,52 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#ifndef __ARCINDEX_HPP_INCLUDED
+#define __ARCINDEX_HPP_INCLUDED
+
+#include "glob.hpp"    // muidx, muint, muvec, mxvec
+#include "arcset.hpp"  // ArcSet
+
+// Lookup of arcs by row and lot: Find(i, j) gives the position of the first
+// arc of row i with lot j, or Arcs() if row i has no such arc, by a binary
+// search of the row. Rows whose lots are already in order are searched in
+// place; only the other rows get a sorted copy of their lots.
+class ArcIndex {
+public:
+  ArcIndex() { };
+  ArcIndex (const ArcSet& A);
+  muint Arcs() const { return pARX.Arcs(); };
+  muint Find (const muint i, const muidx j) const;
+private:
+  ArcSet pARX;  // indexed arcs
+  mxvec  pLOT;  // lots of each unsorted row, in order
+  mxvec  pPOS;  // position within the row of each lot in pLOT
+  muvec  pROW;  // start of each row in pLOT, or Arcs() if the row is sorted
+};
+
+#endif // __ARCINDEX_HPP_INCLUDED
@@ -0,0 +1,75 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#ifndef __ARCSET_HPP_INCLUDED
+#define __ARCSET_HPP_INCLUDED
+
+#include <memory>      // std::shared_ptr
+#include <vector>      // std::vector
+#include "glob.hpp"    // mfloat, mfvec, muidx, muint, muvec, mxvec
+#include "object.hpp"  // Object, objlist, voblist
+
+// Arc costs in compressed sparse row (CSR) form: the arcs of row (bidder) i
+// are the positions Begin(i) <= k < End(i) of the cost and lot arrays. The
+// arrays are immutable and shared, so copying an ArcSet is cheap; they may
+// belong to the ArcSet itself or to an outside owner, such as a file mapping.
+// Bidders keep pointers into the arrays of the ArcSet their auction holds.
+// SetCost changes one cost in place when this ArcSet alone owns its costs;
+// otherwise it first gives this ArcSet a copy of them, moving Costs().
+class ArcSet {
+public:
+  ArcSet() : pCST (nullptr), pLOT (nullptr), pMCST (nullptr),
+             pOFS (nullptr), pNR (0) { };
+  ArcSet (const voblist& A);
+  ArcSet (muvec& O, mxvec& L, mfvec& C);
+  ArcSet (const muint* O, const muidx* L, const mfloat* C, const muint nr,
+          const std::shared_ptr <const void>& M)
+    : pMEM (M), pCST (C), pLOT (L), pMCST (nullptr), pOFS (O), pNR (nr) { };
+  muint  Arcs() const { return (pNR == 0) ? 0 : pOFS[pNR]; };
+  muint  Begin (const muint i) const { return pOFS[i]; };
+  mfloat Cost (const muint k) const { return pCST[k]; };
+  const mfloat* Costs() const { return pCST; };
+  muint  Degree (const muint i) const { return pOFS[i+1] - pOFS[i]; };
+  muint  End (const muint i) const { return pOFS[i+1]; };
+  muidx  Lot (const muint k) const { return pLOT[k]; };
+  const muidx*  Lots() const { return pLOT; };
+  const muint*  Offsets() const { return pOFS; };
+  objlist Row (const muint i) const;
+  void   SetCost (const muint k, const mfloat c);
+  muint  Size() const { return pNR; };
+  ArcSet Transpose (const muint nc) const;
+private:
+  std::shared_ptr <const void> pMEM;  // owner of the arrays
+  const mfloat* pCST;   // arc costs
+  const muidx*  pLOT;   // lot (column) id of each arc
+  mfloat*       pMCST;  // arc costs, if they belong to this ArcSet
+  const muint*  pOFS;   // first arc of each row, then one past the last arc
+  muint         pNR;    // number of rows
+};
+
+#endif // __ARCSET_HPP_INCLUDED
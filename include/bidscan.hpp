@@ -0,0 +1,82 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#ifndef __BIDSCAN_HPP_INCLUDED
+#define __BIDSCAN_HPP_INCLUDED
+
+#include "glob.hpp"    // mfloat, muidx, muint
+#include "object.hpp"  // objlist
+
+// Scan of one bidder's arcs at the current prices PR: the arcs are given by
+// their costs C and lots L. The net value of an arc is its cost less the
+// price of its lot. b is the arc to bid on, v1 its net value, v2 the
+// second-best net value, and w the value that sets the bid: v2 for GA and AP,
+// and for SO the best net value among arcs of a class other than that of b
+// (v2 if there is none).
+//
+// In AP and SO, lot j stands for the unit lots U[j] <= u < U[j+1], all of
+// class j, and PR holds the price of every unit lot; b is the unit lot to bid
+// on, and p the price it was read at. ScanLots and ScanLotsClass scan the
+// arcs at the lowest unit price LP[j] of each lot (c the price, i the unit
+// lot), then look at the unit lots of the best lot only; when the best unit
+// lot is not unique they sort the unit lots of all arcs, as ScanUnits and
+// ScanUnitsClass do. These two visit the unit lots of each arc in turn and
+// read every price with a relaxed atomic load, since in the asynchronous
+// auctions other threads raise prices while a bidder scans them.
+//
+// A single pass finds the best arc when it is unique. When several arcs share
+// the best net value, the arc is chosen by a partial sort of (net value, arc)
+// pairs, made in a reused buffer; it is the arc that a partial sort of the
+// whole arc list would put first, so ties are broken as they always were.
+// The passes over the arcs (ScanBest, ScanLots, ScanLotsClass) use AVX-512
+// or AVX2 gathers when the processor has them; the choice is made once, at
+// startup, and ScanKernel() names it. The passes over unit lots are scalar.
+struct BidScan {
+  BidScan () : b (0), p (0.0), v1 (0.0), v2 (0.0), w (0.0) { }
+  muint  b;   // arc to bid on
+  mfloat p;   // price of unit lot b (AP and SO)
+  mfloat v1;  // net value of arc b
+  mfloat v2;  // second-best net value
+  mfloat w;   // net value that sets the bid
+};
+
+void ScanBest (const mfloat* C, const muidx* L, const muint n,
+               const objlist& PR, BidScan& S);
+const char* ScanKernel ();
+void ScanLots (const mfloat* C, const muidx* L, const muint* U,
+               const muint n, const objlist& PR, const objlist& LP,
+               BidScan& S);
+void ScanLotsClass (const mfloat* C, const muidx* L, const muint* U,
+                    const muint n, const objlist& PR, const objlist& LP,
+                    BidScan& S);
+void ScanUnits (const mfloat* C, const muidx* L, const muint* U,
+                const muint n, const objlist& PR, BidScan& S);
+void ScanUnitsClass (const mfloat* C, const muidx* L, const muint* U,
+                     const muint n, const objlist& PR, BidScan& S);
+
+#endif // __BIDSCAN_HPP_INCLUDED
@@ -0,0 +1,76 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#ifndef __BUFOUT_HPP_INCLUDED
+#define __BUFOUT_HPP_INCLUDED
+
+#include <condition_variable>  // std::condition_variable
+#include <fstream>             // std::ofstream
+#include <mutex>               // std::mutex
+#include <thread>              // std::thread
+#include <vector>              // std::vector
+#include "glob.hpp"            // mfloat, muint
+
+// Buffered text output file. Text is formatted into one of two large buffers;
+// when a buffer is full it is handed to a background thread, which writes it
+// while the other buffer fills. Numbers are formatted without printf: Fix
+// prints exactly as "%.8f" does, and Num prints a value as the graph files do
+// (as an integer if it equals its floor, otherwise with Fix).
+class BufOut {
+public:
+  BufOut (const char* fname);
+  BufOut (const BufOut&) = delete;
+  BufOut& operator= (const BufOut&) = delete;
+  ~BufOut();
+  int  Close ();
+  void Fix (const mfloat v);
+  bool Good() const { return pGOOD; };
+  void Num (const mfloat v);
+  void Put (const char c) { if (pCUR == pEND) { Flush (); } *pCUR++ = c; };
+  void Put (const char* s);
+  void UInt (muint v);
+private:
+  void  Flush ();
+  void  Room (const muint n) { if (muint (pEND - pCUR) < n) { Flush (); } };
+  void  Work ();
+  std::vector <char> pBUF[2];   // the two buffers
+  std::condition_variable pCV;
+  std::ofstream pF;
+  std::mutex pMTX;
+  char* pCUR;     // next free byte of the buffer being filled
+  char* pEND;     // end of the buffer being filled
+  bool  pGOOD;    // file open and every write successful?
+  muint pIDX;     // buffer being filled
+  muint pLEN;     // bytes to write from the other buffer
+  bool  pPEND;    // other buffer waiting to be written?
+  bool  pSTOP;
+  muint pWIDX;    // buffer being written
+  std::thread pTHR;
+};
+
+#endif // __BUFOUT_HPP_INCLUDED
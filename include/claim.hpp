@@ -29,8 +29,6 @@ Science Foundation.
 #ifndef __CLAIM_HPP_INCLUDED
 #define __CLAIM_HPP_INCLUDED
 
-#include <memory>    // std::shared_ptr
-#include <set>       // std::multiset
 #include <vector>    // std::vector
 #include "glob.hpp"  // mfloat, mint
 
@@ -47,8 +45,16 @@ struct Claim {
   }
 };
 
-typedef std::vector     <Claim>  clvec;
-typedef std::multiset   <Claim>  cllist;
-typedef std::unique_ptr <cllist> clptr;
+// change of the weight claimed by bidder bdr: wt is added when positive
+// (Push) and taken away when negative (Pop)
+struct Shift {
+  Shift () : bdr (0), wt (0.0) { }
+  Shift (mint b, mfloat w) : bdr (b), wt (w) { }
+  mint   bdr;  // bidder node id number
+  mfloat wt;   // weight added or taken away
+};
+
+typedef std::vector <Claim> clvec;
+typedef std::vector <Shift> shvec;
 
 #endif // __CLAIM_HPP_INCLUDED
@@ -29,27 +29,36 @@ Science Foundation.
 #ifndef __GABID_HPP_INCLUDED
 #define __GABID_HPP_INCLUDED
 
-#include <algorithm>   // std::nth_element
-#include "glob.hpp"    // mfloat, muint
+#include "glob.hpp"    // mfloat, muidx, muint
+#include "arcset.hpp"  // ArcSet
 #include "claim.hpp"   // Claim
 #include "object.hpp"  // objlist
 
 class GAbid {
 public:
   GAbid();
-  GAbid (const muint id, const mfloat wt, const objlist& A)
-    : pARC (A), pCRWT (0.0), pEPS (1.0), pID (id), pMXWT (wt) { };
-  bool Active() const { return (!equal (pMXWT, pCRWT)); };
-  void MakeBid (const objlist& PR, Claim& C);
-  void Pop (const mfloat amt) { pCRWT -= amt; return; };
-  void Push (const mfloat amt) { pCRWT += amt; return; };
-  void Refresh (const mfloat ep) { pEPS = ep; pCRWT = 0.0; return; };
+  GAbid (const muint id, const mfloat wt, const ArcSet& A, const muint r)
+    : pCRWT (0.0), pCST (A.Costs() + A.Begin (r)), pEPS (1.0), pID (id),
+      pLOT (A.Lots() + A.Begin (r)), pMXWT (wt), pNA (A.Degree (r)) { };
+  bool  Active() const { return (!equal (pMXWT, pCRWT)); };
+  mfloat Best (const objlist& PR) const;
+  muint Load() const { return pNA; };
+  void  MakeBid (const objlist& PR, Claim& C);
+  mfloat Need() const { return (pMXWT - pCRWT); };
+  void  Pop (const mfloat amt) { pCRWT -= amt; return; };
+  void  Push (const mfloat amt) { pCRWT += amt; return; };
+  void  Rebind (const ArcSet& A, const muint r) {
+    pCST = A.Costs() + A.Begin (r); return; };
+  void  Refresh (const mfloat ep) { pEPS = ep; pCRWT = 0.0; return; };
+  void  SetWeight (const mfloat wt) { pMXWT = wt; return; };
 private:
-  objlist pARC;   // arc costs
-  mfloat  pCRWT;  // total weight claimed by bidder
-  mfloat  pEPS;   // epsilon
-  muint   pID;    // bidder id number
-  mfloat  pMXWT;  // total weight needed by bidder
+  mfloat        pCRWT;  // total weight claimed by bidder
+  const mfloat* pCST;   // arc costs (row r of the auction's arcs)
+  mfloat        pEPS;   // epsilon
+  muint         pID;    // bidder id number
+  const muidx*  pLOT;   // lot id of each arc
+  mfloat        pMXWT;  // total weight needed by bidder
+  muint         pNA;    // number of arcs
 };
 
 typedef std::vector<GAbid> GAbdlst;
@@ -29,26 +29,36 @@ Science Foundation.
 #ifndef __GALOT_HPP_INCLUDED
 #define __GALOT_HPP_INCLUDED
 
+#include <functional>  // std::function
 #include <vector>      // std::vector
-#include "glob.hpp"    // mfloat, muint
-#include "claim.hpp"   // Claim, cllist, clptr
+#include "glob.hpp"    // mfloat, mint, muint
+#include "claim.hpp"   // Claim, clvec, Shift, shvec
 #include "object.hpp"  // Object
-#include "gabid.hpp"   // GAbdlst
 
 class GAlot {
 public:
   GAlot();
   GAlot (const muint id, const mfloat wt)
-    : pCLMS (new cllist), pFRWT (wt), pID (id), pMXWT (wt) { };
+    : pFRWT (wt), pID (id), pMXWT (wt) { };
   bool Active() const { return (pFRWT > gEPS); };
-  void Export (cllist& CV) const { CV = *pCLMS; return; }; 
-  void UpdateClaim (Claim& C, Object& P, GAbdlst& B);
-  void Refresh() { pCLMS->clear (); pFRWT = pMXWT; return; };
+  const clvec& Claims() const { return pCLMS; };
+  void Export (clvec& CV) const {
+    CV.assign (pCLMS.rbegin(), pCLMS.rend()); return; };
+  void UpdateClaim (Claim& C, Object& P);
+  void Refresh() { pCLMS.clear (); pFRWT = pMXWT; return; };
+  mfloat Release (const mint b, const mfloat wt,
+                  const std::function <bool (const Claim&)>& drop);
+  void Resize (const mfloat wt, Object& P);
+  void Retain (const std::function <bool (const Claim&)>& keep);
+  const shvec& Shifts() const { return pSHFT; };
+  void ClearShifts() { pSHFT.clear (); return; };
 private:
-  clptr  pCLMS;  // pointer to claim list
+  clvec  pCLMS;  // claims, from highest to lowest (lowest at the back)
   mfloat pFRWT;  // total weight claimed in lot
   muint  pID;    // lot id number
   mfloat pMXWT;  // total weight available in lot
+  shvec  pSHFT;  // bidder weight changes not yet applied, in order
+  void Insert (const Claim& C);
 };
 
 typedef std::vector <GAlot> GAltlst;
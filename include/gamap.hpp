@@ -29,31 +29,64 @@ Science Foundation.
 #ifndef __GAMAP_HPP_INCLUDED
 #define __GAMAP_HPP_INCLUDED
 
-#include <iostream>    // std::cout, std::endl, std::sprintf
-#include <vector>      // std::vector
-#include "glob.hpp"    // mfloat, mfvec, mint, muint
-#include "claim.hpp"   // cllist, clvec
-#include "object.hpp"  // objlist, voblist
-#include "gabid.hpp"   // GAbdlst
-#include "galot.hpp"   // GAltlst
+#include <algorithm>     // std::inplace_merge, std::min, std::remove_if,
+                         //   std::sort, std::stable_sort, std::unique
+#include <chrono>        // std::chrono::duration,
+                         //   std::chrono::high_resolution_clock::now
+#include <iostream>      // std::cout, std::endl, std::sprintf
+#include <numeric>       // std::accumulate
+#include <vector>        // std::vector
+#include "glob.hpp"      // mfloat, mfvec, mint, muint, muvec
+#include "claim.hpp"     // Claim, clvec, Shift, shvec
+#include "object.hpp"    // objlist
+#include "arcset.hpp"    // ArcSet
+#include "arcindex.hpp"  // ArcIndex
+#include "pool.hpp"      // Pool, poolptr
+#include "schedule.hpp"  // Schedule
+#include "gabid.hpp"     // GAbdlst
+#include "galot.hpp"     // GAltlst
 
 class GAmap {
 public:
-  GAmap() : pEPS (1.0), pMN (1.0), pSTP (0.25) { };
-  GAmap (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+  GAmap() : pEPS (1.0), pNB (0), pPS (0.0), pSNE (1.0) { };
+  GAmap (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
          const mfloat MX, const mfloat MN, const mfloat ST);
-  void Solve (objlist& T, mfvec& PR);
+  bool Solve (objlist& T, mfvec& PR);
+  void SetCost (const muint i, const muint j, const mfloat c);
+  void SetDemand (const muint i, const mfloat wt);
+  void SetSupply (const muint j, const mfloat wt);
+  bool Update (objlist& T, mfvec& PR);
+  void Warm (const objlist& T, const mfvec& PR);
 private:
-  GAbdlst pBDR;  // vector of bidders
-  clvec   pCLM;  // vector of current claims
-  mfloat  pEPS;  // current epsilon value
-  GAltlst pLTS;  // lots to be auctioned
-  mfloat  pMN;   // minimum epsilon value
-  objlist pPR;   // vector of prices
-  mfloat  pSTP;  // epsilon step size
+  muvec    pACT;  // bidders that may bid, in order
+  ArcIndex pAIX;  // lookup of the arcs by bidder and lot
+  ArcSet   pARC;  // arcs of the bidders
+  GAbdlst  pBDR;  // vector of bidders
+  mfvec    pBST;  // best net value of each bidder after the last phase
+  clvec    pCLM;  // vector of current claims
+  mfloat   pEPS;  // current epsilon value
+  GAltlst  pLTS;  // lots to be auctioned
+  muint    pNB;   // number of bids made
+  poolptr  pPOL;  // threads of the bid stage
+  objlist  pPR;   // vector of prices
+  mfloat   pPS;   // sum of the prices at the end of the last phase
+  Schedule pSCH;  // epsilon schedule
+  mfloat   pSNE;  // epsilon of the last phase, kept for a time budget
+  GAltlst  pSNL;  // lots after the last phase, kept for a time budget
+  objlist  pSNP;  // prices after the last phase, kept for a time budget
+  void Apply (const muint n, const muint b, const muint e);
   void Auction();
+  void Best();
+  void Export (objlist& T, mfvec& PR) const;
   mint gcd (const mint a, const mint b) const;
-  void Round();
+  void Measure (const muint nb);
+  mfloat Net (const muint i, const muint j, const mfloat pr) const;
+  void Release (const muint j);
+  void Resolve (const muint na);
+  void Restore();
+  void Retain();
+  void Revise (const muint i);
+  bool Round();
 };
 
 #endif // __GAMAP_HPP_INCLUDED
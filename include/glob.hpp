@@ -30,19 +30,28 @@ Science Foundation.
 #define __GLOB_HPP_INCLUDED
 
 #include <cmath>     // std::abs, std::max, std::sqrt
+#include <cstdint>   // std::uint32_t
 #include <vector>    // std::vector
 #include <iostream>  // std::cout, std::endl, std::sprintf
 
 typedef long int          mint;
 typedef unsigned long int muint;
 typedef double            mfloat;
+typedef std::uint32_t     muidx;
 
+typedef std::vector<bool>   mbvec;
 typedef std::vector<mfloat> mfvec;
 typedef std::vector<mint>   mivec;
 typedef std::vector<muint>  muvec;
+typedef std::vector<muidx>  mxvec;
 
+extern bool   gADP;
+extern bool   gASY;
 extern mfloat gEPS;
+extern mfloat gGAP;
 extern mfloat gINF;
+extern muint  gTHR;
+extern mfloat gTME;
 extern muint  gVBS;
 
 inline bool equal(const mfloat x, const mfloat y)
@@ -0,0 +1,74 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#ifndef __POOL_HPP_INCLUDED
+#define __POOL_HPP_INCLUDED
+
+#include <algorithm>           // std::lower_bound, std::min
+#include <condition_variable>  // std::condition_variable
+#include <functional>          // std::function
+#include <memory>              // std::shared_ptr
+#include <mutex>               // std::mutex
+#include <thread>              // std::thread
+#include <vector>              // std::vector
+#include "glob.hpp"            // muint, muvec
+
+// Fixed set of worker threads. Run(n, f) calls f(0), ..., f(n-1), spread over
+// the workers and the calling thread, and returns once every call is done.
+// A pool of size one runs everything on the calling thread. Split(S, f, m)
+// calls f(b, e) on ranges [b, e) of 0, ..., n-1 that carry about the same
+// load, given the running totals S[0] = 0, ..., S[n] of the loads; a total
+// load below m is not worth splitting.
+class Pool {
+public:
+  Pool (const muint n);
+  Pool (const Pool&) = delete;
+  Pool& operator= (const Pool&) = delete;
+  ~Pool();
+  void  Run (const muint n, const std::function <void (muint)>& f);
+  void  Split (const muvec& S, const std::function <void (muint, muint)>& f,
+               const muint m = muint (1) << 15);
+  muint Size() const { return pWRK.size() + 1; };
+private:
+  void  Work ();
+  void  Take ();
+  std::condition_variable pCV;    // wakes workers for a new job
+  std::condition_variable pDONE;  // wakes the caller when the job is done
+  std::mutex pMTX;
+  const std::function <void (muint)>* pJOB;  // current job
+  muint pGEN;   // job counter, advanced by every Run
+  muint pLEFT;  // calls of the current job not yet finished
+  muint pN;     // number of calls in the current job
+  muint pNXT;   // next call to hand out
+  bool  pSTOP;
+  std::vector <std::thread> pWRK;
+};
+
+typedef std::shared_ptr <Pool> poolptr;
+
+#endif // __POOL_HPP_INCLUDED
@@ -0,0 +1,89 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#ifndef __SCHEDULE_HPP_INCLUDED
+#define __SCHEDULE_HPP_INCLUDED
+
+#include <chrono>      // std::chrono::duration, std::chrono::duration_cast,
+                       //   std::chrono::steady_clock
+#include <cmath>       // std::abs, std::sqrt
+#include <iostream>    // std::cout, std::endl, std::sprintf
+#include "glob.hpp"    // gADP, gGAP, gTME, gVBS, mfloat, muint
+
+// Epsilon schedule of an auction. Each auction calls Next for the epsilon of
+// a phase, runs the phase, reports it with Phase, and goes on while More. The
+// fixed schedule multiplies epsilon by the step size until it falls below the
+// minimum; with gADP the step also follows the statistics of the last phase.
+// With gGAP > 0, every schedule also stops after the first phase that leaves a
+// relative duality gap (dual less primal cost, over the primal cost) below it.
+// With gTME > 0, the time budget runs from construction; once it is spent and
+// a phase has been completed, Late tells the auction to give up its phase,
+// and Cut tells whether the budget stopped the schedule; Renew starts a new
+// budget for a re-solve.
+class Schedule {
+public:
+  Schedule() : pADP (false), pCUT (false), pDC (0.0), pHIT (false),
+               pMN (1.0), pNB (0), pNBD (0), pNBP (0), pPC (0.0), pPH (0),
+               pRS (0.0), pSTP (0.25), pTMD (false), pWT (1.0) { };
+  Schedule (const mfloat MN, const mfloat ST, const mfloat WT)
+    : pADP (gADP), pCUT (false), pDC (0.0),
+      pEND (std::chrono::steady_clock::now() +
+            std::chrono::duration_cast <std::chrono::steady_clock::duration>
+              (std::chrono::duration <mfloat> (gTME))),
+      pHIT (false), pMN (MN), pNB (0), pNBD (0), pNBP (0), pPC (0.0),
+      pPH (0), pRS (0.0), pSTP (ST), pTMD (gTME > 0.0), pWT (WT) { };
+  bool   Cut() const { return pCUT; };
+  void   Halt();
+  bool   Late() const {
+    return ((pTMD) && (pPH > 0) && (std::chrono::steady_clock::now() > pEND));
+  };
+  bool   More (const mfloat ep);
+  mfloat Next (const mfloat ep) const;
+  void   Phase (const mfloat ep, const muint nb, const muint nbd,
+                const mfloat rs, const mfloat pc, const mfloat dc);
+  void   Renew();
+  bool   Timed() const { return pTMD; };
+private:
+  bool   pADP;  // adaptive schedule
+  bool   pCUT;  // the time budget stopped the schedule
+  mfloat pDC;   // dual cost at the end of the last phase
+  std::chrono::steady_clock::time_point pEND;  // end of the time budget
+  bool   pHIT;  // relative gap of the last phase below gGAP
+  mfloat pMN;   // minimum epsilon value
+  muint  pNB;   // bids made in the last phase
+  muint  pNBD;  // number of bidders
+  muint  pNBP;  // bids made in the phase before the last
+  mfloat pPC;   // primal cost at the end of the last phase
+  muint  pPH;   // number of phases run
+  mfloat pRS;   // mean price rise in the last phase, in units of its epsilon
+  mfloat pSTP;  // epsilon step size
+  bool   pTMD;  // time budget set
+  mfloat pWT;   // total weight of the bidders
+};
+
+#endif // __SCHEDULE_HPP_INCLUDED
@@ -29,29 +29,35 @@ Science Foundation.
 #ifndef __SOBID_HPP_INCLUDED
 #define __SOBID_HPP_INCLUDED
 
-#include <algorithm>   // std::nth_element
-#include <cmath>       // std::isinf
-#include "glob.hpp"    // mfloat, muint
+#include "glob.hpp"    // mfloat, muidx, muint, muvec
+#include "arcset.hpp"  // ArcSet
 #include "object.hpp"  // objlist
 
 class SObid {
 public:
-  SObid() : pCRWT (0), pEPS (1.0), pID (0), pMXWT (0) { };
-  SObid (const muint inid, const muint sim, const muint wt, const objlist& A)
-    : pARC (A), pCRWT (0), pEPS (1.0), pID (inid), pMXWT (wt), pSIM (sim) { };
+  SObid() : pCRWT (0), pCST (nullptr), pEPS (1.0), pID (0), pLOT (nullptr),
+            pMXWT (0), pNA (0), pNU (0), pSIM (0), pUNT (nullptr) { };
+  SObid (const muint inid, const muint sim, const muint wt, const ArcSet& A,
+         const muvec& U);
   bool  Active() const { return (pMXWT > pCRWT); };
+  mfloat Best (const objlist& PR) const;
   muint Class() const { return pSIM; };
-  void  MakeBid (const objlist& PR, Object& D);
+  muint Load() const { return pNU; };
+  void  MakeBid (const objlist& PR, const objlist& LP, Object& D);
   void  Pop() { pCRWT -= 1; return; };
   void  Push() { pCRWT += 1; return; };
   void  Refresh (const mfloat ep) { pEPS = ep; pCRWT = 0; return; };
 private:
-  objlist pARC;   // arc costs (c = cost, i = similarity class, j = object id)
-  muint   pCRWT;  // total weight claimed by bidder
-  mfloat  pEPS;   // epsilon
-  muint   pID;    // bidder id number
-  muint   pMXWT;  // total weight needed by bidder
-  muint   pSIM;   // bidder similarity class
+  muint         pCRWT;  // total weight claimed by bidder
+  const mfloat* pCST;   // arc costs (row sim of the auction's arcs)
+  mfloat        pEPS;   // epsilon
+  muint         pID;    // bidder id number
+  const muidx*  pLOT;   // lot id (similarity class) of each arc
+  muint         pMXWT;  // total weight needed by bidder
+  muint         pNA;    // number of arcs
+  muint         pNU;    // number of unit lots of the arcs
+  muint         pSIM;   // bidder similarity class
+  const muint*  pUNT;   // first unit lot of each lot
 };
 
 typedef std::vector<SObid> SObidlist;
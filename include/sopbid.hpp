@@ -31,25 +31,32 @@ Science Foundation.
 
 #include <algorithm>   // std::nth_element, std::sort
 #include <cmath>       // std::isinf
-#include "glob.hpp"    // mfloat, muint
+#include "glob.hpp"    // mfloat, muidx, muint, muvec
+#include "arcset.hpp"  // ArcSet
 #include "object.hpp"  // objlist
 
 class SOPbid {
 public:
-  SOPbid() : pCRWT (0), pEPS (1.0), pID (0), pMXWT (0) { };
-  SOPbid (const muint inid, const muint wt, const objlist& A)
-    : pARC (A), pCRWT (0), pEPS (1.0), pID (inid), pMXWT (wt) { };
-  bool Active() const { return (pMXWT > pCRWT); };
-  void MakeBid (const objlist& PR, objlist& D);
-  void Pop() { pCRWT -= 1; return; };
-  void Push() { pCRWT += 1; return; };
-  void Refresh (const mfloat ep) { pEPS = ep; pCRWT = 0; return; };
+  SOPbid() : pCRWT (0), pCST (nullptr), pEPS (1.0), pID (0), pLOT (nullptr),
+             pMXWT (0), pNA (0), pNU (0), pUNT (nullptr) { };
+  SOPbid (const muint inid, const muint wt, const ArcSet& A, const muvec& U);
+  bool  Active() const { return (pMXWT > pCRWT); };
+  mfloat Best (const objlist& PR) const;
+  muint Load() const { return pNU; };
+  void  MakeBid (const objlist& PR, objlist& D);
+  void  Pop() { pCRWT -= 1; return; };
+  void  Push() { pCRWT += 1; return; };
+  void  Refresh (const mfloat ep) { pEPS = ep; pCRWT = 0; return; };
 private:
-  objlist pARC;   // arc costs
-  muint   pCRWT;  // total weight claimed by bidder
-  mfloat  pEPS;   // epsilon
-  muint   pID;    // bidder id number
-  muint   pMXWT;  // total weight needed by bidder
+  muint         pCRWT;  // total weight claimed by bidder
+  const mfloat* pCST;   // arc costs (row inid of the auction's arcs)
+  mfloat        pEPS;   // epsilon
+  muint         pID;    // bidder id number
+  const muidx*  pLOT;   // lot id (similarity class) of each arc
+  muint         pMXWT;  // total weight needed by bidder
+  muint         pNA;    // number of arcs
+  muint         pNU;    // number of unit lots of the arcs
+  const muint*  pUNT;   // first unit lot of each lot
 };
 
 typedef std::vector<SOPbid> SOPbidlist;
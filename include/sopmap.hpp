@@ -29,32 +29,52 @@ Science Foundation.
 #ifndef __SOPMAP_HPP_INCLUDED
 #define __SOPMAP_HPP_INCLUDED
 
-#include <algorithm>   // std::sort
-#include <cmath>       // std::floor
-#include <iostream>    // std::cout, std::endl, std::sprintf
-#include <vector>      // std::vector
-#include "glob.hpp"    // mfloat, mfvec, mint, muint
-#include "object.hpp"  // objlist, voblist
-#include "sopbid.hpp"  // SOPbidlist
+#include <algorithm>     // std::inplace_merge, std::remove_if, std::sort,
+                         //   std::unique
+#include <cmath>         // std::floor
+#include <iostream>      // std::cout, std::endl, std::sprintf
+#include <numeric>       // std::accumulate
+#include <vector>        // std::vector
+#include "glob.hpp"      // mbvec, mfloat, mfvec, mint, muint, muvec
+#include "object.hpp"    // objlist
+#include "arcset.hpp"    // ArcSet
+#include "arcindex.hpp"  // ArcIndex
+#include "pool.hpp"      // Pool, poolptr
+#include "schedule.hpp"  // Schedule
+#include "sopbid.hpp"    // SOPbidlist
 
 class SOPmap {
 public:
-  SOPmap() : pEPS (1.0), pGCD (1), pMN (1.0), pSTP (0.25) { };
-  SOPmap (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+  SOPmap() : pEPS (1.0), pGCD (1), pNB (0), pPS (0.0), pSNE (1.0) { };
+  SOPmap (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
           const mfloat MX, const mfloat MN, const mfloat ST);
   void Solve (objlist& T, mfvec& PR);
 private:
+  muvec      pACT;  // bidders that may bid, in order
+  ArcIndex   pAIX;  // lookup of the arcs by bidder and lot
+  ArcSet     pARC;  // arcs of the bidders
   SOPbidlist pBDR;  // vector of bidders
   voblist    pBID;  // vector of current bids
+  mbvec      pCHG;  // lots taken in the current iteration
   mfloat     pEPS;  // current epsilon value
   mint       pGCD;  // gcd of weights
-  mfloat     pMN;   // minimum epsilon value
+  muint      pNB;   // number of bids made
+  poolptr    pPOL;  // threads of the bid stage
   objlist    pPR;   // vector of prices
-  mfloat     pSTP;  // epsilon step size
+  mfloat     pPS;   // sum of the prices at the end of the last phase
+  Schedule   pSCH;  // epsilon schedule
+  mfvec      pSLK;  // slack of the holder of each unit lot
+  mfloat     pSNE;  // epsilon of the last phase, kept for a time budget
+  objlist    pSNP;  // prices after the last phase, kept for a time budget
+  muvec      pUNT;  // first unit lot of each lot, then the number of units
   void Auction();
   mint gcd (const mint a, const mint b) const;
-  void Round();
-  void UpdateClaims();
+  void Measure (const muint nb);
+  mfloat Net (const muint n, const muint u) const;
+  void Restore();
+  void Retain();
+  bool Round();
+  void UpdateClaims (const muint na);
 };
 
 #endif // __SOPMAP_HPP_INCLUDED
@@ -27,24 +27,54 @@ Science Foundation.
 ---------------------------------------------------------------------------- **/
 
 #include "apbid.hpp"
+#include "bidscan.hpp"  // BidScan, ScanLots, ScanUnits
+
+/** --- Standard Constructor ---------------------------------------------------
+ * the bidder reads row sim of A; lot j of A stands for the unit lots
+ * U[j] <= u < U[j+1]
+ **/
+APbid::APbid (const muint inid, const muint sim, const muint wt,
+              const ArcSet& A, const muvec& U)
+  : pCRWT (0), pCST (A.Costs() + A.Begin (sim)), pEPS (1.0), pID (inid),
+    pLOT (A.Lots() + A.Begin (sim)), pMXWT (wt), pNA (A.Degree (sim)),
+    pNU (0), pSIM (sim), pUNT (U.data())
+{
+  for (muint k = 0; k < pNA; k++) {
+    pNU += pUNT[pLOT[k] + 1] - pUNT[pLOT[k]];
+  }
+}
+
+/** --- Best -------------------------------------------------------------------
+ * best net value (cost less price) over the unit lots of the arcs
+ **/
+mfloat APbid::Best (const objlist& PR) const {
+  if (pNU > 1) {
+    BidScan S;
+    ScanUnits (pCST, pLOT, pUNT, pNA, PR, S);
+    return S.v1;
+  }
+  return pCST[0] - PR[pUNT[pLOT[0]]].c;
+}
 
 /** --- MakeBid ----------------------------------------------------------------
+ * LP holds the lowest price of each lot, with its unit lot; if it is empty,
+ * the scan visits every unit lot of the arcs
  **/
-void APbid::MakeBid (const objlist& PR, Object& D) {
+void APbid::MakeBid (const objlist& PR, const objlist& LP, Object& D) {
   D.j = -1;
   if (pMXWT > pCRWT) {
     D.i = mint (pID);
-    if (pARC.size() > 1) {
-      objlist M = pARC;
-      for (muint it = 0; it < M.size(); it++) {
-        M[it].c -= PR[muint (M[it].j)].c;
+    if (pNU > 1) {
+      BidScan S;
+      if (LP.empty()) {
+        ScanUnits (pCST, pLOT, pUNT, pNA, PR, S);
+      } else {
+        ScanLots (pCST, pLOT, pUNT, pNA, PR, LP, S);
       }
-      std::nth_element (M.begin(), M.begin() + 1, M.end(),
-        [](const Object& a, const Object& b) -> bool { return (a.c > b.c); });
-      D.j = M[0].j;
-      D.c = M[0].c + PR[muint (M[0].j)].c + pEPS - M[1].c;
+      D.j = mint (S.b);
+      D.c = S.v1 + S.p + pEPS - S.w;
     } else {
-      D.j = pARC[0].j;
+      D.j = mint (pUNT[pLOT[0]]);
       D.c = gINF;
     }
   }
@@ -30,9 +30,12 @@ Science Foundation.
 
 /** --- Standard Constructor ---------------------------------------------------
  **/
-APmap::APmap (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+APmap::APmap (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
               const mfloat MX, const mfloat MN, const mfloat ST)
-  : pEPS (MX), pGCD (1), pMN (MN), pSTP (ST)
+  : pEPS (MX), pGCD (1), pNB (0), pPOL (std::make_shared <Pool> (gTHR)),
+    pPS (0.0),
+    pSCH (MN, ST, std::accumulate (DWT.begin(), DWT.end(), mfloat (0.0))),
+    pSNE (MX)
 {
   pBDR.clear();
   pBID.clear();
@@ -78,20 +81,16 @@ APmap::APmap (const mfvec& DWT, const mfvec& SWT, const voblist& A,
         }
       }
       pBID = objlist (pPR.size(), Object (0.0, -1, -1));
+      pCHG = mbvec (pPR.size(), false);
+      pSLK = mfvec (pPR.size(), 0.0);
+      pARC = A;
+      pAIX = ArcIndex (pARC);
+      pUNT.swap (pos);
       pBDR.reserve (pPR.size());
-      objlist tA;
       i = 0;
       for (muint it = 0; it < DWT.size(); it++) {
-        tA.clear();
-        for (muint m = 0; m < A[it].size(); m++) {
-          for (muint n = 0;
-               n < muint (SWT[muint (A[it][m].j)]) / muint (pGCD); n++) {
-            tA.emplace_back (A[it][m].c, A[it][m].j,
-                             pos[muint (A[it][m].j)] + n);
-          }
-        }
         for (muint n = 0; n < muint (DWT[it]) / muint (pGCD); n++) {
-          pBDR.emplace_back (i, it, 1, tA);
+          pBDR.emplace_back (i, it, 1, pARC, pUNT);
           pBDR.back().Refresh (pEPS);
           i++;
         }
@@ -113,7 +112,18 @@ void APmap::Solve (objlist& T, mfvec& PR) {
   T.clear();
   PR.clear();
   if (!pBDR.empty()) {
+    std::chrono::high_resolution_clock::time_point t1, t2;
+    t1 = std::chrono::high_resolution_clock::now();
     Auction();
+    t2 = std::chrono::high_resolution_clock::now();
+    if (gVBS > 0) {
+      char str[255];
+      std::chrono::duration <mfloat> dur = t2 - t1;
+      std::sprintf (str,
+                    "  - Assignment auction bids : %lu bids, %.3e bids/sec",
+                    pNB, mfloat (pNB) / dur.count());
+      std::cout << str << std::endl;
+    }
     muint k;
     muint n = 0;
     std::sort (pPR.begin(), pPR.end(),
@@ -140,19 +150,99 @@ void APmap::Solve (objlist& T, mfvec& PR) {
   return;
 }
 
+/** --- Async ------------------------------------------------------------------
+ * Gauss-Seidel form of Round: every thread takes unassigned bidders, first
+ * from the shared list pACT and then from its own stack, and installs each bid
+ * as soon as it is made. The install is lock-based, not lock-free: the price
+ * and owner of a unit lot must change together, and the 24-byte Object does
+ * not fit one compare-and-swap, so a unit lot is locked by a spinlock that
+ * swaps its owner with -2; the bid is installed if it still beats the price,
+ * the evicted owner goes on the thread's stack, and a bidder that was outbid
+ * in the meantime bids again. The bidders read prices that other threads may
+ * be raising, with relaxed atomic loads matching the relaxed atomic stores
+ * made here, so the result depends on the timing of the threads. Every 1024
+ * bids a thread checks the time budget; false if the phase was given up.
+ **/
+bool APmap::Async() {
+  pACT.clear();
+  for (muint it = 0; it < pBDR.size(); it++) {
+    if (pBDR[it].Active()) {
+      pACT.push_back (it);
+    }
+  }
+  std::atomic <muint> nxt (0);
+  std::atomic <muint> nb (0);
+  std::atomic <bool> lt (false);
+  pPOL->Run (pPOL->Size(), [this, &nxt, &nb, &lt](const muint) {
+    muvec stk;
+    const objlist lp;
+    Object D;
+    muint ct = 0;
+    while (!lt.load (std::memory_order_relaxed)) {
+      if (((ct & 1023) == 0) && (pSCH.Late())) {
+        lt = true;
+        break;
+      }
+      muint b;
+      if (!stk.empty()) {
+        b = stk.back();
+        stk.pop_back();
+      } else {
+        b = nxt.fetch_add (1);
+        if (b >= pACT.size()) {
+          break;
+        }
+        b = pACT[b];
+      }
+      pBDR[b].MakeBid (pPR, lp, D);
+      ++ct;
+      Object& P = pPR[muint (D.j)];
+      mint o = __atomic_load_n (&P.i, __ATOMIC_RELAXED);
+      while ((o == -2) ||
+             (!__atomic_compare_exchange_n (&P.i, &o, mint (-2), false,
+                                            __ATOMIC_ACQUIRE,
+                                            __ATOMIC_RELAXED))) {
+        if (o == -2) {
+          std::this_thread::yield ();
+          o = __atomic_load_n (&P.i, __ATOMIC_RELAXED);
+        }
+      }
+      if (P < D) {
+        __atomic_store (&P.c, &D.c, __ATOMIC_RELAXED);
+        pBDR[b].Push();
+        __atomic_store_n (&P.i, D.i, __ATOMIC_RELEASE);
+        if (o != -1) {
+          pBDR[muint (o)].Pop();
+          stk.push_back (muint (o));
+        }
+      } else {
+        __atomic_store_n (&P.i, o, __ATOMIC_RELEASE);
+        stk.push_back (b);
+      }
+    }
+    nb += ct;
+  });
+  pNB += nb;
+  return (!lt);
+}
+
 /** --- Auction ----------------------------------------------------------------
  **/
 void APmap::Auction() {
   do {
-    pEPS *= pSTP;
+    pEPS = pSCH.Next (pEPS);
+    const muint nb = pNB;
     for (muint it = 0; it < pBDR.size(); it++) {
       pBDR[it].Refresh (pEPS);
     }
-    for (auto it = pPR.begin(); it < pPR.end(); it++) {
-      it->i = -1;
+    Retain();
+    if (!((gASY) ? Async() : Round())) {
+      pSCH.Halt ();
+      Restore ();
+      break;
     }
-    Round();
-  } while (pEPS >= pMN);
+    Measure (pNB - nb);
+  } while (pSCH.More (pEPS));
   return;
 }
 
@@ -162,48 +252,266 @@ mint APmap::gcd (const mint a, const mint b) const {
   return (b == 0) ? a : gcd (b, a % b);
 }
 
+/** --- Low --------------------------------------------------------------------
+ * finds the lowest price of lot j and the first unit lot with it; an empty
+ * lot has price gINF
+ **/
+void APmap::Low (const muint j) {
+  pLP[j].c = gINF;
+  pLP[j].i = mint (pUNT[j]);
+  pLP[j].j = mint (j);
+  for (muint u = pUNT[j]; u < pUNT[j + 1]; u++) {
+    if (pPR[u].c < pLP[j].c) {
+      pLP[j].c = pPR[u].c;
+      pLP[j].i = mint (u);
+    }
+  }
+  return;
+}
+
+/** --- Lows -------------------------------------------------------------------
+ **/
+void APmap::Lows() {
+  pLP.resize (pUNT.size() - 1);
+  for (muint j = 0; j < pLP.size(); j++) {
+    Low (j);
+  }
+  return;
+}
+
+/** --- Measure ----------------------------------------------------------------
+ * ends a phase: finds the best net value of every bidder and the slack (best
+ * net value less net value) of the unit lot it holds, and reports the phase,
+ * with its primal and dual costs, to pSCH
+ **/
+void APmap::Measure (const muint nb) {
+  const muint nu = pPR.size();
+  muvec hd;
+  mfvec bs;
+  Slack (hd, bs);
+  mfloat pc = 0.0;
+  mfloat dc = 0.0;
+  mfloat ps = 0.0;
+  for (muint u = 0; u < nu; u++) {
+    ps += pPR[u].c;
+  }
+  for (muint n = 0; n < pBDR.size(); n++) {
+    if (hd[n] < nu) {
+      dc += bs[n] + pPR[hd[n]].c;
+      pc += bs[n] - pSLK[hd[n]] + pPR[hd[n]].c;
+    }
+  }
+  pSCH.Phase (pEPS, nb, pBDR.size(), (ps - pPS) / (mfloat (nu) * pEPS),
+              pc * mfloat (pGCD), dc * mfloat (pGCD));
+  pPS = ps;
+  if (pSCH.Timed()) {
+    pSNE = pEPS;
+    pSNP = pPR;
+  }
+  return;
+}
+
+/** --- Net --------------------------------------------------------------------
+ * net value of unit lot u to bidder n, or -gINF if no arc of the bidder leads
+ * to the lot of u
+ **/
+mfloat APmap::Net (const muint n, const muint u) const {
+  const muint k = pAIX.Find (pBDR[n].Class(), muidx (pPR[u].j));
+  return (k == pAIX.Arcs()) ? -gINF : pARC.Cost (k) - pPR[u].c;
+}
+
+/** --- Restore ----------------------------------------------------------------
+ * goes back to the end of the last phase when a phase was given up: the
+ * prices and holders kept by Measure return, with the epsilon of that phase,
+ * and every bidder counts the unit lots it holds again
+ **/
+void APmap::Restore() {
+  pPR  = pSNP;
+  pEPS = pSNE;
+  for (muint it = 0; it < pBDR.size(); it++) {
+    pBDR[it].Refresh (pEPS);
+  }
+  for (muint u = 0; u < pPR.size(); u++) {
+    if (pPR[u].i != -1) {
+      pBDR[muint (pPR[u].i)].Push();
+    }
+  }
+  return;
+}
+
+/** --- Retain -----------------------------------------------------------------
+ * starts a phase from the assignment of the last one: a bidder keeps its unit
+ * lot while the slack of the lot is within pEPS (eps-complementary
+ * slackness), and loses it otherwise
+ **/
+void APmap::Retain() {
+  for (muint u = 0; u < pPR.size(); u++) {
+    if (pPR[u].i != -1) {
+      if (pSLK[u] > pEPS) {
+        pPR[u].i = -1;
+      } else {
+        pBDR[muint (pPR[u].i)].Push();
+      }
+    }
+  }
+  return;
+}
+
 /** --- Round ------------------------------------------------------------------
+ * only the bidders in pACT bid; a bidder that is not active can only become
+ * active again by losing a lot, and then joins pACT for the next iteration;
+ * false if the phase was given up at the end of the time budget
  **/
-void APmap::Round() {
-  bool avail = true;
-  muint n;
-  while (avail) {
-    // get new bids
-    for (muint it = 0; it < pBDR.size(); it++) {
-      pBDR[it].MakeBid (pPR, pBID[it]);
+bool APmap::Round() {
+  pACT.clear();
+  for (muint it = 0; it < pBDR.size(); it++) {
+    if (pBDR[it].Active()) {
+      pACT.push_back (it);
+    }
+  }
+  Lows();
+  while (!pACT.empty()) {
+    if (pSCH.Late()) {
+      return false;
     }
+    const muint na = pACT.size();
+    // get new bids, split over the threads by the work of each bid
+    muvec ld (na + 1, 0);
+    for (muint n = 0; n < na; n++) {
+      ld[n + 1] = ld[n] + pBDR[pACT[n]].Load();
+    }
+    pPOL->Split (ld, [this](const muint b, const muint e) {
+      for (muint n = b; n < e; n++) {
+        pBDR[pACT[n]].MakeBid (pPR, pLP, pBID[pACT[n]]);
+      }
+    });
     // select winners from bids
-    UpdateClaims();
-    avail = false;
-    n = pBDR.size();
-    while ((!avail) && (n > 0)) { avail = pBDR[--n].Active(); }
+    UpdateClaims (na);
+    // keep the bidders that are still active, in order
+    std::sort (pACT.begin() + mint (na), pACT.end());
+    std::inplace_merge (pACT.begin(), pACT.begin() + mint (na), pACT.end());
+    pACT.erase (std::unique (pACT.begin(), pACT.end()), pACT.end());
+    pACT.erase (std::remove_if (pACT.begin(), pACT.end(),
+      [this](const muint b) -> bool { return !pBDR[b].Active(); }),
+      pACT.end());
+  }
+  return true;
+}
+
+/** --- Slack ------------------------------------------------------------------
+ * finds the unit lot hd[n] held by each bidder (pPR.size() if none), its best
+ * net value bs[n], and the slack pSLK of each unit lot held
+ **/
+void APmap::Slack (muvec& hd, mfvec& bs) {
+  const muint nu = pPR.size();
+  hd.assign (pBDR.size(), nu);
+  for (muint u = 0; u < nu; u++) {
+    if (pPR[u].i != -1) {
+      hd[muint (pPR[u].i)] = u;
+    }
   }
+  bs.assign (pBDR.size(), 0.0);
+  muvec ld (pBDR.size() + 1, 0);
+  for (muint n = 0; n < pBDR.size(); n++) {
+    ld[n + 1] = ld[n] + pBDR[n].Load();
+  }
+  pPOL->Split (ld, [this, &hd, &bs, nu](const muint b, const muint e) {
+    for (muint n = b; n < e; n++) {
+      bs[n] = pBDR[n].Best (pPR);
+      if (hd[n] < nu) {
+        pSLK[hd[n]] = bs[n] - Net (n, hd[n]);
+      }
+    }
+  });
   return;
 }
 
 /** --- UpdateClaims -----------------------------------------------------------
+ * takes the bids of the first na bidders of pACT; outbid bidders are added to
+ * pACT
  **/
-void APmap::UpdateClaims() {
-  std::vector <bool> ch (pPR.size(), false);
-  for (muint it = 0; it < pBID.size(); it++) {
+void APmap::UpdateClaims (const muint na) {
+  muvec ch;
+  for (muint n = 0; n < na; n++) {
+    const muint it = pACT[n];
+    if (pBID[it].j > -1) {
+      ++pNB;
+    }
     if ((pBID[it].j > -1) && (pPR[muint (pBID[it].j)] < pBID[it])) {
-      if (!ch[muint (pBID[it].j)]) {
-        ch[muint (pBID[it].j)] = true;
+      if (!pCHG[muint (pBID[it].j)]) {
+        pCHG[muint (pBID[it].j)] = true;
+        ch.push_back (muint (pBID[it].j));
         if (pPR[muint (pBID[it].j)].i != -1) {
           pBDR[muint (pPR[muint (pBID[it].j)].i)].Pop();
+          pACT.push_back (muint (pPR[muint (pBID[it].j)].i));
         }
       }
       pPR[muint (pBID[it].j)].c = pBID[it].c;
       pPR[muint (pBID[it].j)].i = pBID[it].i;
     }
   }
-  // apply results to bidders
+  // apply results to bidders; prices only rise, so the lowest price of a
+  // lot changes only if its unit lot was taken
   for (muint k = 0; k < ch.size(); k++) {
-    if (ch[k]) {
-      pBDR[muint (pPR[k].i)].Push();
+    pCHG[ch[k]] = false;
+    pBDR[muint (pPR[ch[k]].i)].Push();
+    if (pLP[muint (pPR[ch[k]].j)].i == mint (ch[k])) {
+      Low (muint (pPR[ch[k]].j));
     }
   }
   return;
 }
 
+/** --- Warm -------------------------------------------------------------------
+ * starts from the prices PR (one per lot) and plan T of an earlier solve of a
+ * graph with the same lots: every unit lot takes the price of its lot, and the
+ * flow of each entry of T, in units of pGCD, goes to free bidders of its class
+ * on free unit lots of its lot; the first phase then keeps the unit lots that
+ * satisfy eps-complementary slackness
+ **/
+void APmap::Warm (const objlist& T, const mfvec& PR) {
+  if ((pBDR.empty()) || (PR.size() + 1 != pUNT.size())) {
+    return;
+  }
+  const muint nl = PR.size();
+  for (muint j = 0; j < nl; j++) {
+    for (muint u = pUNT[j]; u < pUNT[j + 1]; u++) {
+      pPR[u].c = PR[j];
+    }
+  }
+  // the bidders of a class are consecutive: nx is the next free bidder of
+  // each class and en the end of its bidders; fu is the next free unit lot
+  const muint nc = pBDR.back().Class() + 1;
+  muvec nx (nc, pBDR.size());
+  muvec en (nc, 0);
+  for (muint n = 0; n < pBDR.size(); n++) {
+    nx[pBDR[n].Class()] = std::min (nx[pBDR[n].Class()], n);
+    en[pBDR[n].Class()] = n + 1;
+  }
+  muvec fu (pUNT.begin(), pUNT.end() - 1);
+  for (const Object& O : T) {
+    if (   (O.i > -1) && (muint (O.i) < nc) && (O.j > -1)
+        && (muint (O.j) < nl) && (nx[muint (O.i)] < en[muint (O.i)])
+        && (Net (nx[muint (O.i)], pUNT[muint (O.j)]) > -gINF)) {
+      const muint c = muint (O.i);
+      const muint j = muint (O.j);
+      muint k = muint (std::floor (O.c / mfloat (pGCD) + 0.5));
+      while ((k > 0) && (nx[c] < en[c]) && (fu[j] < pUNT[j + 1])) {
+        pPR[fu[j]].i = mint (nx[c]);
+        ++nx[c];
+        ++fu[j];
+        --k;
+      }
+    }
+  }
+  muvec hd;
+  mfvec bs;
+  Slack (hd, bs);
+  pPS = 0.0;
+  for (muint u = 0; u < pPR.size(); u++) {
+    pPS += pPR[u].c;
+  }
+  return;
+}
+
 /// ----------------------------------------------------------------------------
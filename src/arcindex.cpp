@@ -0,0 +1,82 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#include <algorithm>    // std::is_sorted, std::lower_bound, std::sort
+#include <cstdint>      // std::uint64_t
+#include <vector>       // std::vector
+#include "arcindex.hpp"
+
+/** --- Standard Constructor ---------------------------------------------------
+ * rows are sorted by (lot, position), so that equal lots keep their order
+ **/
+ArcIndex::ArcIndex (const ArcSet& A)
+  : pARX (A), pROW (A.Size(), A.Arcs())
+{
+  const muidx* L = A.Lots();
+  std::vector <std::uint64_t> K;
+  for (muint i = 0; i < A.Size(); i++) {
+    if (std::is_sorted (L + A.Begin (i), L + A.End (i))) {
+      continue;
+    }
+    K.clear();
+    for (muint k = A.Begin (i); k < A.End (i); k++) {
+      K.push_back ((std::uint64_t (L[k]) << 32) | (k - A.Begin (i)));
+    }
+    std::sort (K.begin(), K.end());
+    pROW[i] = pLOT.size();
+    for (muint it = 0; it < K.size(); it++) {
+      pLOT.push_back (muidx (K[it] >> 32));
+      pPOS.push_back (muidx (K[it]));
+    }
+  }
+}
+
+/** --- Find -------------------------------------------------------------------
+ **/
+muint ArcIndex::Find (const muint i, const muidx j) const {
+  const muidx* b;
+  const muidx* e;
+  const muidx* p;
+  if (pROW[i] == pARX.Arcs()) {
+    b = pARX.Lots() + pARX.Begin (i);
+    e = pARX.Lots() + pARX.End (i);
+  } else {
+    b = pLOT.data() + pROW[i];
+    e = b + pARX.Degree (i);
+  }
+  p = std::lower_bound (b, e, j);
+  if ((p == e) || (*p != j)) {
+    return pARX.Arcs();
+  }
+  if (pROW[i] == pARX.Arcs()) {
+    return pARX.Begin (i) + muint (p - b);
+  }
+  return pARX.Begin (i) + pPOS[pROW[i] + muint (p - b)];
+}
+
+/// ----------------------------------------------------------------------------
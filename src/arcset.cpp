@@ -0,0 +1,166 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#include <algorithm>   // std::lower_bound, std::max, std::min
+#include "arcset.hpp"
+#include "pool.hpp"    // Pool
+
+struct ArcBuf {
+  muvec O;  // row offsets
+  mxvec L;  // lot ids
+  mfvec C;  // costs
+};
+
+struct CostBuf {
+  std::shared_ptr <const void> M;  // owner of the offsets and lot ids
+  mfvec C;                         // costs
+};
+
+/** --- List Constructor -------------------------------------------------------
+ **/
+ArcSet::ArcSet (const voblist& A)
+  : pCST (nullptr), pLOT (nullptr), pMCST (nullptr), pOFS (nullptr), pNR (0)
+{
+  muvec O (1, 0);
+  mxvec L;
+  mfvec C;
+  O.reserve (A.size() + 1);
+  for (muint i = 0; i < A.size(); i++) {
+    O.push_back (O.back() + A[i].size());
+  }
+  L.reserve (O.back());
+  C.reserve (O.back());
+  for (muint i = 0; i < A.size(); i++) {
+    for (muint j = 0; j < A[i].size(); j++) {
+      L.push_back (muidx (A[i][j].j));
+      C.push_back (A[i][j].c);
+    }
+  }
+  *this = ArcSet (O, L, C);
+}
+
+/** --- Array Constructor ------------------------------------------------------
+ * takes over the contents of O, L, and C, leaving them empty
+ **/
+ArcSet::ArcSet (muvec& O, mxvec& L, mfvec& C)
+  : pCST (nullptr), pLOT (nullptr), pMCST (nullptr), pOFS (nullptr), pNR (0)
+{
+  std::shared_ptr <ArcBuf> B (new ArcBuf);
+  B->O.swap (O);
+  B->L.swap (L);
+  B->C.swap (C);
+  if (!B->O.empty()) {
+    pCST  = B->C.data();
+    pLOT  = B->L.data();
+    pMCST = B->C.data();
+    pOFS  = B->O.data();
+    pNR   = B->O.size() - 1;
+  }
+  pMEM = B;
+}
+
+/** --- Row --------------------------------------------------------------------
+ **/
+objlist ArcSet::Row (const muint i) const {
+  objlist R;
+  R.reserve (Degree (i));
+  for (muint k = pOFS[i]; k < pOFS[i+1]; k++) {
+    R.emplace_back (pCST[k], mint (i), mint (pLOT[k]));
+  }
+  return R;
+}
+
+/** --- SetCost ----------------------------------------------------------------
+ * sets the cost of arc k to c; costs shared with another ArcSet, or owned by
+ * an outside owner, are first copied, so the other holders never see the
+ * change; only the costs are copied, and the offsets and lot ids stay shared
+ **/
+void ArcSet::SetCost (const muint k, const mfloat c) {
+  if ((pMCST == nullptr) || (pMEM.use_count() > 1)) {
+    std::shared_ptr <CostBuf> B (new CostBuf);
+    B->M = pMEM;
+    B->C.assign (pCST, pCST + Arcs());
+    pCST  = B->C.data();
+    pMCST = B->C.data();
+    pMEM  = B;
+  }
+  pMCST[k] = c;
+  return;
+}
+
+/** --- Transpose --------------------------------------------------------------
+ * returns the arcs indexed by lot, for nc lots; within each new row the arcs
+ * keep the order of the original rows; the rows are split into one block of
+ * about equal arcs per thread, and every block is read twice: the first pass
+ * counts the arcs of every lot, so that the second can place each arc
+ * directly at its final position
+ **/
+ArcSet ArcSet::Transpose (const muint nc) const {
+  muint nk = std::max (muint (1), std::min (gTHR, Arcs() >> 16));
+  muvec B (nk + 1, pNR);  // block boundaries (rows)
+  B[0] = 0;
+  for (muint k = 1; k < nk; k++) {
+    B[k] = muint (std::lower_bound (pOFS, pOFS + pNR, (Arcs() * k) / nk)
+                  - pOFS);
+  }
+  std::vector <muvec> CNT (nk, muvec (nc, 0));  // arcs of each lot per block
+  Pool pool (nk);
+  pool.Run (nk, [&] (muint k) {
+    muvec& N = CNT[k];
+    for (muint i = B[k]; i < B[k+1]; i++) {
+      for (muint q = pOFS[i]; q < pOFS[i+1]; q++) {
+        ++N[pLOT[q]];
+      }
+    }
+  });
+  // CNT[k][j] becomes the first position of block k within new row j
+  muvec O (nc + 1, 0);
+  for (muint j = 0; j < nc; j++) {
+    muint pos = O[j];
+    for (muint k = 0; k < nk; k++) {
+      muint n = CNT[k][j];
+      CNT[k][j] = pos;
+      pos += n;
+    }
+    O[j+1] = pos;
+  }
+  mxvec L (Arcs());
+  mfvec C (Arcs());
+  pool.Run (nk, [&] (muint k) {
+    muvec& P = CNT[k];
+    for (muint i = B[k]; i < B[k+1]; i++) {
+      for (muint q = pOFS[i]; q < pOFS[i+1]; q++) {
+        L[P[pLOT[q]]]   = muidx (i);
+        C[P[pLOT[q]]++] = pCST[q];
+      }
+    }
+  });
+  return ArcSet (O, L, C);
+}
+
+/// ----------------------------------------------------------------------------
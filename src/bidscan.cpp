@@ -0,0 +1,571 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#include <algorithm>   // std::max, std::nth_element, std::sort
+#include <vector>      // std::vector
+#include "bidscan.hpp"
+
+#if defined (__x86_64__) && (defined (__clang__) || (__GNUC__ >= 5))
+#define BIDSCAN_X86
+#include <immintrin.h>  // _mm256_*, _mm512_*, _mm_loadu_si128
+#endif
+
+struct NetArc {
+  mfloat c;  // net value
+  muint  k;  // arc
+};
+
+// net values of a bidder's arcs, in arc order; one buffer per thread
+static thread_local std::vector <NetArc> tNET;
+static thread_local mfvec tVAL;
+static thread_local muvec tUNT;
+static thread_local mfvec tPRC;
+static thread_local mxvec tCLS;
+
+// prices are read as every third double of the price list
+static_assert (sizeof (Object) == 3 * sizeof (mfloat),
+               "price gathers need 24-byte objects");
+
+typedef void (*NetFn) (const mfloat* C, const muidx* L, const muint n,
+                       const mfloat* P, mfloat* V);
+typedef void (*Top2Fn) (const mfloat* C, const muidx* L, const muint n,
+                        const mfloat* P, BidScan& S);
+
+/** --- Load -------------------------------------------------------------------
+ * price of unit lot O, read with a relaxed atomic load: in the asynchronous
+ * auctions other threads raise prices while the bidders scan them
+ **/
+static inline mfloat Load (const Object& O) {
+  mfloat c;
+  __atomic_load (&O.c, &c, __ATOMIC_RELAXED);
+  return c;
+}
+
+/** --- Merge ------------------------------------------------------------------
+ * adds the best value m1 (at arc ix) and second-best value m2 of one lane to
+ * the running results of S
+ **/
+static inline void Merge (const mfloat m1, const muint ix, const mfloat m2,
+                          BidScan& S) {
+  if (m1 > S.v1) {
+    S.v2 = std::max (S.v1, m2);
+    S.v1 = m1;
+    S.b  = ix;
+  } else if (m1 < S.v1) {
+    S.v2 = std::max (S.v2, m1);
+  } else {
+    S.v2 = m1;
+    S.b  = std::min (S.b, ix);
+  }
+  return;
+}
+
+/** --- NetScalar --------------------------------------------------------------
+ **/
+static void NetScalar (const mfloat* C, const muidx* L, const muint n,
+                       const mfloat* P, mfloat* V) {
+  for (muint k = 0; k < n; k++) {
+    V[k] = C[k] - P[3 * muint (L[k])];
+  }
+  return;
+}
+
+/** --- Top2Scalar -------------------------------------------------------------
+ **/
+static void Top2Scalar (const mfloat* C, const muidx* L, const muint n,
+                        const mfloat* P, BidScan& S) {
+  mfloat v;
+  S.b  = 0;
+  S.v1 = C[0] - P[3 * muint (L[0])];
+  S.v2 = -gINF;
+  for (muint k = 1; k < n; k++) {
+    v = C[k] - P[3 * muint (L[k])];
+    if (v > S.v1) {
+      S.v2 = S.v1;
+      S.v1 = v;
+      S.b  = k;
+    } else if (v > S.v2) {
+      S.v2 = v;
+    }
+  }
+  return;
+}
+
+#ifdef BIDSCAN_X86
+/** --- NetAVX2 ----------------------------------------------------------------
+ * the lot ids are widened and tripled into 64-bit indices of the price list
+ **/
+__attribute__ ((target ("avx2")))
+static void NetAVX2 (const mfloat* C, const muidx* L, const muint n,
+                     const mfloat* P, mfloat* V) {
+  muint k = 0;
+  for (; k + 4 <= n; k += 4) {
+    __m256i l = _mm256_cvtepu32_epi64 (
+      _mm_loadu_si128 (reinterpret_cast <const __m128i*> (L + k)));
+    l = _mm256_add_epi64 (l, _mm256_slli_epi64 (l, 1));
+    _mm256_storeu_pd (V + k, _mm256_sub_pd (_mm256_loadu_pd (C + k),
+                                            _mm256_i64gather_pd (P, l, 8)));
+  }
+  for (; k < n; k++) {
+    V[k] = C[k] - P[3 * muint (L[k])];
+  }
+  return;
+}
+
+/** --- Top2AVX2 ---------------------------------------------------------------
+ * each of the four lanes keeps its own best value (and arc) and second-best
+ * value; the lanes and the last few arcs are merged at the end
+ **/
+__attribute__ ((target ("avx2")))
+static void Top2AVX2 (const mfloat* C, const muidx* L, const muint n,
+                      const mfloat* P, BidScan& S) {
+  __m256d m1 = _mm256_set1_pd (-gINF);
+  __m256d m2 = m1;
+  __m256i ix = _mm256_setzero_si256 ();
+  __m256i kv = _mm256_setr_epi64x (0, 1, 2, 3);
+  const __m256i k4 = _mm256_set1_epi64x (4);
+  muint k = 0;
+  for (; k + 4 <= n; k += 4) {
+    __m256i l = _mm256_cvtepu32_epi64 (
+      _mm_loadu_si128 (reinterpret_cast <const __m128i*> (L + k)));
+    l = _mm256_add_epi64 (l, _mm256_slli_epi64 (l, 1));
+    __m256d v  = _mm256_sub_pd (_mm256_loadu_pd (C + k),
+                                _mm256_i64gather_pd (P, l, 8));
+    __m256d gt = _mm256_cmp_pd (v, m1, _CMP_GT_OQ);
+    m2 = _mm256_blendv_pd (_mm256_max_pd (m2, v), m1, gt);
+    m1 = _mm256_blendv_pd (m1, v, gt);
+    ix = _mm256_castpd_si256 (_mm256_blendv_pd (_mm256_castsi256_pd (ix),
+                                                 _mm256_castsi256_pd (kv), gt));
+    kv = _mm256_add_epi64 (kv, k4);
+  }
+  alignas (32) mfloat A1[4];
+  alignas (32) mfloat A2[4];
+  alignas (32) muint  AX[4];
+  _mm256_store_pd (A1, m1);
+  _mm256_store_pd (A2, m2);
+  _mm256_store_si256 (reinterpret_cast <__m256i*> (AX), ix);
+  S.b  = 0;
+  S.v1 = -gINF;
+  S.v2 = -gINF;
+  for (muint it = 0; it < 4; it++) {
+    Merge (A1[it], AX[it], A2[it], S);
+  }
+  for (; k < n; k++) {
+    Merge (C[k] - P[3 * muint (L[k])], k, -gINF, S);
+  }
+  return;
+}
+
+/** --- NetAVX512 --------------------------------------------------------------
+ **/
+__attribute__ ((target ("avx512f")))
+static void NetAVX512 (const mfloat* C, const muidx* L, const muint n,
+                       const mfloat* P, mfloat* V) {
+  muint k = 0;
+  for (; k + 8 <= n; k += 8) {
+    __m512i l = _mm512_cvtepu32_epi64 (
+      _mm256_loadu_si256 (reinterpret_cast <const __m256i*> (L + k)));
+    l = _mm512_add_epi64 (l, _mm512_slli_epi64 (l, 1));
+    _mm512_storeu_pd (V + k, _mm512_sub_pd (_mm512_loadu_pd (C + k),
+                                            _mm512_i64gather_pd (l, P, 8)));
+  }
+  for (; k < n; k++) {
+    V[k] = C[k] - P[3 * muint (L[k])];
+  }
+  return;
+}
+
+/** --- Top2AVX512 -------------------------------------------------------------
+ * as Top2AVX2, with eight lanes
+ **/
+__attribute__ ((target ("avx512f")))
+static void Top2AVX512 (const mfloat* C, const muidx* L, const muint n,
+                        const mfloat* P, BidScan& S) {
+  __m512d m1 = _mm512_set1_pd (-gINF);
+  __m512d m2 = m1;
+  __m512i ix = _mm512_setzero_si512 ();
+  __m512i kv = _mm512_setr_epi64 (0, 1, 2, 3, 4, 5, 6, 7);
+  const __m512i k8 = _mm512_set1_epi64 (8);
+  muint k = 0;
+  for (; k + 8 <= n; k += 8) {
+    __m512i l = _mm512_cvtepu32_epi64 (
+      _mm256_loadu_si256 (reinterpret_cast <const __m256i*> (L + k)));
+    l = _mm512_add_epi64 (l, _mm512_slli_epi64 (l, 1));
+    __m512d   v  = _mm512_sub_pd (_mm512_loadu_pd (C + k),
+                                  _mm512_i64gather_pd (l, P, 8));
+    __mmask8  gt = _mm512_cmp_pd_mask (v, m1, _CMP_GT_OQ);
+    m2 = _mm512_mask_blend_pd (gt, _mm512_max_pd (m2, v), m1);
+    m1 = _mm512_mask_blend_pd (gt, m1, v);
+    ix = _mm512_mask_blend_epi64 (gt, ix, kv);
+    kv = _mm512_add_epi64 (kv, k8);
+  }
+  alignas (64) mfloat A1[8];
+  alignas (64) mfloat A2[8];
+  alignas (64) muint  AX[8];
+  _mm512_store_pd (A1, m1);
+  _mm512_store_pd (A2, m2);
+  _mm512_store_si512 (AX, ix);
+  S.b  = 0;
+  S.v1 = -gINF;
+  S.v2 = -gINF;
+  for (muint it = 0; it < 8; it++) {
+    Merge (A1[it], AX[it], A2[it], S);
+  }
+  for (; k < n; k++) {
+    Merge (C[k] - P[3 * muint (L[k])], k, -gINF, S);
+  }
+  return;
+}
+#endif // BIDSCAN_X86
+
+struct Kernels {
+  const char* name;
+  NetFn       net;
+  Top2Fn      top2;
+};
+
+/** --- Pick -------------------------------------------------------------------
+ * chooses the widest kernels the processor supports
+ **/
+static Kernels Pick () {
+#ifdef BIDSCAN_X86
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx512f")) {
+    return Kernels { "avx512", NetAVX512, Top2AVX512 };
+  }
+  if (__builtin_cpu_supports ("avx2")) {
+    return Kernels { "avx2", NetAVX2, Top2AVX2 };
+  }
+#endif
+  return Kernels { "scalar", NetScalar, Top2Scalar };
+}
+
+static const Kernels kSCAN = Pick ();
+
+/** --- Fill -------------------------------------------------------------------
+ * fills tNET from the net values V and puts the two best first, exactly as
+ * the bidders once did with their copied arc lists
+ **/
+static void Fill (const mfloat* V, const muint n) {
+  tNET.resize (n);
+  for (muint k = 0; k < n; k++) {
+    tNET[k].c = V[k];
+    tNET[k].k = k;
+  }
+  std::nth_element (tNET.begin(), tNET.begin() + 1, tNET.end(),
+    [](const NetArc& a, const NetArc& b) -> bool { return (a.c > b.c); });
+  return;
+}
+
+/** --- ScanBest ---------------------------------------------------------------
+ * requires n > 1
+ **/
+void ScanBest (const mfloat* C, const muidx* L, const muint n,
+               const objlist& PR, BidScan& S) {
+  kSCAN.top2 (C, L, n, &PR[0].c, S);
+  if (!(S.v1 > S.v2)) {
+    tVAL.resize (n);
+    kSCAN.net (C, L, n, &PR[0].c, tVAL.data());
+    Fill (tVAL.data(), n);
+    S.b  = tNET[0].k;
+    S.v1 = tNET[0].c;
+    S.v2 = tNET[1].c;
+  }
+  S.w = S.v2;
+  return;
+}
+
+/** --- FillUnits --------------------------------------------------------------
+ * as Fill, for the unit lots of the arcs, in the order ScanUnits visits them;
+ * tUNT, tPRC and tCLS receive the unit lot, its price and its class of every
+ * entry
+ **/
+static void FillUnits (const mfloat* C, const muidx* L, const muint* U,
+                       const muint n, const objlist& PR) {
+  muint m = 0;
+  for (muint k = 0; k < n; k++) {
+    m += U[L[k] + 1] - U[L[k]];
+  }
+  tNET.resize (m);
+  tUNT.resize (m);
+  tPRC.resize (m);
+  tCLS.resize (m);
+  m = 0;
+  for (muint k = 0; k < n; k++) {
+    for (muint u = U[L[k]]; u < U[L[k] + 1]; u++) {
+      tPRC[m]   = Load (PR[u]);
+      tNET[m].c = C[k] - tPRC[m];
+      tNET[m].k = m;
+      tUNT[m]   = u;
+      tCLS[m]   = L[k];
+      m++;
+    }
+  }
+  std::nth_element (tNET.begin(), tNET.begin() + 1, tNET.end(),
+    [](const NetArc& a, const NetArc& b) -> bool { return (a.c > b.c); });
+  return;
+}
+
+/** --- TieUnits ---------------------------------------------------------------
+ * the results of ScanUnits from the buffers of FillUnits
+ **/
+static void TieUnits (BidScan& S) {
+  S.b  = tUNT[tNET[0].k];
+  S.p  = tPRC[tNET[0].k];
+  S.v1 = tNET[0].c;
+  S.v2 = tNET[1].c;
+  S.w  = S.v2;
+  return;
+}
+
+/** --- TieUnitsClass ----------------------------------------------------------
+ * the results of ScanUnitsClass from the buffers of FillUnits
+ **/
+static void TieUnitsClass (BidScan& S) {
+  muint m = tNET.size();
+  if (tCLS[tNET[0].k] != tCLS[tNET[1].k]) {
+    S.w = tNET[1].c;
+  } else {
+    std::sort (tNET.begin(), tNET.end(),
+      [](const NetArc& a, const NetArc& b) -> bool { return (a.c > b.c); });
+    muint ct = 2;
+    while ((ct < m) && (tCLS[tNET[ct].k] == tCLS[tNET[0].k])) {
+      ++ct;
+    }
+    S.w = (ct < m) ? tNET[ct].c : tNET[1].c;
+  }
+  S.b  = tUNT[tNET[0].k];
+  S.p  = tPRC[tNET[0].k];
+  S.v1 = tNET[0].c;
+  S.v2 = tNET[1].c;
+  return;
+}
+
+/** --- ScanUnits --------------------------------------------------------------
+ * requires at least two unit lots; the net values go straight into tNET, so
+ * that a tie costs only the partial sort
+ **/
+void ScanUnits (const mfloat* C, const muidx* L, const muint* U,
+                const muint n, const objlist& PR, BidScan& S) {
+  muint m = 0;
+  for (muint k = 0; k < n; k++) {
+    m += U[L[k] + 1] - U[L[k]];
+  }
+  tNET.resize (m);
+  tUNT.resize (m);
+  tPRC.resize (m);
+  S.b  = 0;
+  S.v1 = -gINF;
+  S.v2 = -gINF;
+  m = 0;
+  for (muint k = 0; k < n; k++) {
+    for (muint u = U[L[k]]; u < U[L[k] + 1]; u++) {
+      tPRC[m] = Load (PR[u]);
+      const mfloat v = C[k] - tPRC[m];
+      tNET[m].c = v;
+      tNET[m].k = m;
+      tUNT[m]   = u;
+      if (v > S.v1) {
+        S.v2 = S.v1;
+        S.v1 = v;
+        S.b  = u;
+        S.p  = tPRC[m];
+      } else if (v > S.v2) {
+        S.v2 = v;
+      }
+      m++;
+    }
+  }
+  if (!(S.v1 > S.v2)) {
+    std::nth_element (tNET.begin(), tNET.begin() + 1, tNET.end(),
+      [](const NetArc& a, const NetArc& b) -> bool { return (a.c > b.c); });
+    TieUnits (S);
+    return;
+  }
+  S.w = S.v2;
+  return;
+}
+
+/** --- ScanUnitsClass ---------------------------------------------------------
+ * requires at least two unit lots; along with the best unit and its class,
+ * the pass keeps the third-best net value and the best net value among units
+ * of any other class; the partial sort is also needed when the second-best
+ * net value is shared, since the sorted list was always searched for w from
+ * its third entry on
+ **/
+void ScanUnitsClass (const mfloat* C, const muidx* L, const muint* U,
+                     const muint n, const objlist& PR, BidScan& S) {
+  mfloat c;
+  mfloat v;
+  mfloat v3 = -gINF;  // third-best net value
+  muidx  cl = 0;      // class of the best unit
+  bool   ok = false;  // a unit of another class was seen
+  bool   st = true;   // no unit was seen yet
+  S.b  = 0;
+  S.v1 = -gINF;
+  S.v2 = -gINF;
+  S.w  = -gINF;
+  for (muint k = 0; k < n; k++) {
+    for (muint u = U[L[k]]; u < U[L[k] + 1]; u++) {
+      c = Load (PR[u]);
+      v = C[k] - c;
+      if (st) {
+        S.v1 = v;
+        S.b  = u;
+        S.p  = c;
+        cl   = L[k];
+        st   = false;
+      } else if (v > S.v1) {
+        if (L[k] != cl) {
+          S.w = S.v1;
+          ok  = true;
+        }
+        v3   = S.v2;
+        S.v2 = S.v1;
+        S.v1 = v;
+        S.b  = u;
+        S.p  = c;
+        cl   = L[k];
+      } else {
+        if (v > S.v2) {
+          v3   = S.v2;
+          S.v2 = v;
+        } else if (v > v3) {
+          v3 = v;
+        }
+        if ((L[k] != cl) && ((!ok) || (v > S.w))) {
+          S.w = v;
+          ok  = true;
+        }
+      }
+    }
+  }
+  if ((S.v1 > S.v2) && (S.v2 > v3)) {
+    if (!ok) {
+      S.w = S.v2;
+    }
+    return;
+  }
+  FillUnits (C, L, U, n, PR);
+  TieUnitsClass (S);
+  return;
+}
+
+/** --- TopLots ----------------------------------------------------------------
+ * scans the arcs at the lowest unit prices LP of their lots; if the best unit
+ * lot is unique, returns true with S.b that unit lot, S.v1 its net value, and
+ * S.v2 the second-best net value over all unit lots of the arcs; T.v2 is left
+ * as the second-best net value over the arcs, and vl as the best net value
+ * over the other unit lots of the best lot
+ **/
+static bool TopLots (const mfloat* C, const muidx* L, const muint* U,
+                     const muint n, const objlist& PR, const objlist& LP,
+                     BidScan& T, BidScan& S, mfloat& vl) {
+  kSCAN.top2 (C, L, n, &LP[0].c, T);
+  if (!(T.v1 > T.v2)) {
+    return false;
+  }
+  const muint j  = L[T.b];
+  const muint ub = muint (LP[j].i);
+  vl = -gINF;
+  for (muint u = U[j]; u < U[j + 1]; u++) {
+    if (u != ub) {
+      vl = std::max (vl, C[T.b] - PR[u].c);
+    }
+  }
+  if (!(T.v1 > vl)) {
+    return false;
+  }
+  S.b  = ub;
+  S.p  = LP[j].c;
+  S.v1 = T.v1;
+  S.v2 = std::max (T.v2, vl);
+  return true;
+}
+
+/** --- ScanLots ---------------------------------------------------------------
+ * requires at least two unit lots; gives the results of ScanUnits; when the
+ * best unit lot is not unique, the net values of all unit lots go to the
+ * partial sort at once
+ **/
+void ScanLots (const mfloat* C, const muidx* L, const muint* U,
+               const muint n, const objlist& PR, const objlist& LP,
+               BidScan& S) {
+  BidScan T;
+  mfloat  vl;
+  if (TopLots (C, L, U, n, PR, LP, T, S, vl)) {
+    S.w = S.v2;
+    return;
+  }
+  FillUnits (C, L, U, n, PR);
+  TieUnits (S);
+  return;
+}
+
+/** --- ScanLotsClass ----------------------------------------------------------
+ * requires at least two unit lots; gives the results of ScanUnitsClass; the
+ * second-best arc is of another class unless some other arc shares the lot
+ * of the best one, which is left to ScanUnitsClass; as there, a second-best
+ * net value shared by the best class and another one goes to the partial
+ * sort
+ **/
+void ScanLotsClass (const mfloat* C, const muidx* L, const muint* U,
+                    const muint n, const objlist& PR, const objlist& LP,
+                    BidScan& S) {
+  BidScan T;
+  mfloat  vl;
+  if ((!TopLots (C, L, U, n, PR, LP, T, S, vl)) || (vl == T.v2)) {
+    FillUnits (C, L, U, n, PR);
+    TieUnitsClass (S);
+    return;
+  }
+  const muint j = L[T.b];
+  muint sh = 0;      // arcs that share the lot of the best arc
+  bool  ok = false;  // an arc of another class has a unit lot
+  for (muint k = 0; k < n; k++) {
+    if (L[k] == j) {
+      ++sh;
+    } else if (U[L[k]] < U[L[k] + 1]) {
+      ok = true;
+    }
+  }
+  if (sh > 1) {
+    ScanUnitsClass (C, L, U, n, PR, S);
+    return;
+  }
+  S.w = (ok) ? T.v2 : S.v2;
+  return;
+}
+
+/** --- ScanKernel -------------------------------------------------------------
+ **/
+const char* ScanKernel () {
+  return kSCAN.name;
+}
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,191 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#include <cmath>       // std::abs, std::floor, std::fma, std::fmod,
+                       //   std::signbit
+#include <cstdio>      // std::snprintf
+#include "bufout.hpp"
+
+static const muint BUFSZ = muint (1) << 22;  // bytes per buffer
+
+/** --- Standard Constructor ---------------------------------------------------
+ **/
+BufOut::BufOut (const char* fname)
+  : pF (fname, std::ios::out | std::ios::trunc | std::ios::binary),
+    pCUR (nullptr), pEND (nullptr), pGOOD (false), pIDX (0), pLEN (0),
+    pPEND (false), pSTOP (false), pWIDX (1) {
+  pBUF[0].resize (BUFSZ);
+  pBUF[1].resize (BUFSZ);
+  pCUR = pBUF[0].data();
+  pEND = pCUR + BUFSZ;
+  if (pF.is_open()) {
+    pGOOD = true;
+    pTHR  = std::thread (&BufOut::Work, this);
+  }
+}
+
+/** --- Destructor -------------------------------------------------------------
+ **/
+BufOut::~BufOut() {
+  Close ();
+}
+
+/** --- Close ------------------------------------------------------------------
+ * writes out all text and closes the file; returns 0 on success
+ **/
+int BufOut::Close () {
+  if (pTHR.joinable()) {
+    Flush ();
+    {
+      std::unique_lock <std::mutex> lk (pMTX);
+      pCV.wait (lk, [this] { return (!pPEND); });
+      pSTOP = true;
+    }
+    pCV.notify_all ();
+    pTHR.join ();
+    pF.close ();
+  }
+  return (pGOOD) ? 0 : 1;
+}
+
+/** --- Fix --------------------------------------------------------------------
+ * below 9e7, v * 10^8 is the rounded product p plus its exact error e, which
+ * is enough to round to 8 decimals exactly (ties to even, as printf does)
+ **/
+void BufOut::Fix (const mfloat v) {
+  mfloat a = std::abs (v);
+  if (!(a < 9.0e7)) {
+    char str[400];
+    std::snprintf (str, sizeof (str), "%.8f", v);
+    Put (str);
+    return;
+  }
+  mfloat p = a * 1e8;
+  mfloat e = std::fma (a, 1e8, -p);
+  mfloat f = std::floor (p);
+  mfloat d = p - f;
+  if (   (d > 0.5)
+      || ((d >= 0.5) && ((e > 0.0)
+                         || ((e >= 0.0) && (std::fmod (f, 2.0) > 0.0))))) {
+    f += 1.0;
+  }
+  muint n = muint (f);
+  Room (32);
+  if (std::signbit (v)) {
+    *pCUR++ = '-';
+  }
+  UInt (n / 100000000);
+  *pCUR++ = '.';
+  n %= 100000000;
+  for (muint it = 8; it > 0; it--) {
+    pCUR[it - 1] = char ('0' + n % 10);
+    n /= 10;
+  }
+  pCUR += 8;
+}
+
+/** --- Flush ------------------------------------------------------------------
+ * hands the filled part of the current buffer to the writer thread, waiting
+ * for it to finish the other buffer first, and starts on the other buffer
+ **/
+void BufOut::Flush () {
+  muint len = muint (pCUR - pBUF[pIDX].data());
+  if (len == 0) {
+    return;
+  }
+  {
+    std::unique_lock <std::mutex> lk (pMTX);
+    pCV.wait (lk, [this] { return (!pPEND); });
+    pLEN  = len;
+    pPEND = true;
+    pWIDX = pIDX;
+  }
+  pCV.notify_all ();
+  pIDX ^= 1;
+  pCUR  = pBUF[pIDX].data();
+  pEND  = pCUR + BUFSZ;
+}
+
+/** --- Num --------------------------------------------------------------------
+ **/
+void BufOut::Num (const mfloat v) {
+  if (equal (v, std::floor (v))) {
+    UInt (muint (v));
+  } else {
+    Fix (v);
+  }
+}
+
+/** --- Put --------------------------------------------------------------------
+ **/
+void BufOut::Put (const char* s) {
+  while (*s != '\0') {
+    Put (*s++);
+  }
+}
+
+/** --- UInt -------------------------------------------------------------------
+ **/
+void BufOut::UInt (muint v) {
+  char  dig[20];
+  muint nd = 0;
+  do {
+    dig[nd++] = char ('0' + v % 10);
+    v /= 10;
+  } while (v > 0);
+  Room (nd);
+  while (nd > 0) {
+    *pCUR++ = dig[--nd];
+  }
+}
+
+/** --- Work -------------------------------------------------------------------
+ * writer thread: writes each buffer handed over by Flush
+ **/
+void BufOut::Work () {
+  std::unique_lock <std::mutex> lk (pMTX);
+  while (true) {
+    pCV.wait (lk, [this] { return ((pPEND) || (pSTOP)); });
+    if (!pPEND) {
+      return;
+    }
+    const char* b = pBUF[pWIDX].data();
+    muint len = pLEN;
+    lk.unlock ();
+    pF.write (b, std::streamsize (len));
+    bool ok = pF.good();
+    lk.lock ();
+    if (!ok) {
+      pGOOD = false;
+    }
+    pPEND = false;
+    pCV.notify_all ();
+  }
+}
+
+/// ----------------------------------------------------------------------------
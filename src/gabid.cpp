@@ -27,23 +27,32 @@ Science Foundation.
 ---------------------------------------------------------------------------- **/
 
 #include "gabid.hpp"
+#include "bidscan.hpp"  // BidScan, ScanBest
+
+/** --- Best -------------------------------------------------------------------
+ * best net value (cost less price) over the arcs
+ **/
+mfloat GAbid::Best (const objlist& PR) const {
+  if (pNA > 1) {
+    BidScan S;
+    ScanBest (pCST, pLOT, pNA, PR, S);
+    return S.v1;
+  }
+  return pCST[0] - PR[pLOT[0]].c;
+}
 
 /** --- MakeBid ----------------------------------------------------------------
  **/
 void GAbid::MakeBid (const objlist& PR, Claim& C) {
   C = Claim (mint (pID), -1, 0.0, 0.0);
   if (!equal(pMXWT, pCRWT)) {
-    if (pARC.size() > 1) {
-      objlist M = pARC;
-      for (muint it = 0; it < M.size(); it++) {
-        M[it].c -= PR[muint (M[it].j)].c;
-      }
-      std::nth_element (M.begin(), M.begin() + 1, M.end(),
-        [](const Object& a, const Object& b) -> bool { return (a.c > b.c); });
-      C.dst = M[0].j;
-      C.pr  = M[0].c + PR[muint (M[0].j)].c + pEPS - M[1].c;
+    if (pNA > 1) {
+      BidScan S;
+      ScanBest (pCST, pLOT, pNA, PR, S);
+      C.dst = mint (pLOT[S.b]);
+      C.pr  = S.v1 + PR[pLOT[S.b]].c + pEPS - S.w;
     } else {
-      C.dst = pARC[0].j;
+      C.dst = mint (pLOT[0]);
       C.pr  = gINF;
     }
     C.wt  = pMXWT - pCRWT;
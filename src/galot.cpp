@@ -26,11 +26,101 @@ those of the author and do not necessarily reflect the views of the National
 Science Foundation.
 ---------------------------------------------------------------------------- **/
 
+#include <algorithm>  // std::lower_bound
 #include "galot.hpp"
 
+/** --- Insert -----------------------------------------------------------------
+ * adds C below every claim that is not lower than it, i.e. ahead of the
+ * claims equal to it, as the claim list always placed new claims
+ **/
+void GAlot::Insert (const Claim& C) {
+  pCLMS.insert (std::lower_bound (pCLMS.begin(), pCLMS.end(), C,
+    [](const Claim& a, const Claim& b) -> bool { return !(a < b); }), C);
+  return;
+}
+
+/** --- Release ----------------------------------------------------------------
+ * takes away up to wt of the weight of the claims of bidder b for which drop
+ * is true, lowest claims first, and returns the weight taken; the lot keeps
+ * its price, and the weight taken is appended to pSHFT for the caller to apply
+ **/
+mfloat GAlot::Release (const mint b, const mfloat wt,
+                       const std::function <bool (const Claim&)>& drop) {
+  mfloat tk = 0.0;  // weight taken
+  for (muint k = pCLMS.size(); (k > 0) && (wt - tk > gEPS); k--) {
+    if ((pCLMS[k - 1].bdr == b) && (drop (pCLMS[k - 1]))) {
+      Claim tmp = pCLMS[k - 1];
+      pCLMS.erase (pCLMS.begin() + mint (k - 1));
+      if (tmp.wt - (wt - tk) > gEPS) {
+        tmp.wt -= wt - tk;
+        Insert (tmp);
+        pFRWT += wt - tk;
+        pSHFT.emplace_back (b, -(wt - tk));
+        tk = wt;
+      } else {
+        pFRWT += tmp.wt;
+        pSHFT.emplace_back (b, -tmp.wt);
+        tk += tmp.wt;
+      }
+    }
+  }
+  return tk;
+}
+
+/** --- Resize -----------------------------------------------------------------
+ * sets the weight of the lot to wt; if the claims exceed it, the lowest give
+ * up the difference, and the weight they lose is appended to pSHFT
+ **/
+void GAlot::Resize (const mfloat wt, Object& P) {
+  mfloat df = (pMXWT - pFRWT) - wt;
+  pMXWT = wt;
+  while ((df > gEPS) && (!pCLMS.empty())) {
+    Claim tmp = pCLMS.back ();
+    pCLMS.pop_back ();
+    if (tmp.wt - df > gEPS) {
+      tmp.wt -= df;
+      Insert (tmp);
+      if (tmp.bdr > -1) {
+        pSHFT.emplace_back (tmp.bdr, -df);
+      }
+      df = 0.0;
+    } else {
+      if (tmp.bdr > -1) {
+        pSHFT.emplace_back (tmp.bdr, -tmp.wt);
+      }
+      df -= tmp.wt;
+    }
+  }
+  pFRWT = (df > 0.0) ? 0.0 : -df;
+  if ((pFRWT < gEPS) && (!pCLMS.empty())) {
+    P.c = pCLMS.back().pr;
+  }
+  return;
+}
+
+/** --- Retain -----------------------------------------------------------------
+ * keeps the claims for which keep is true, in order, and drops the rest; the
+ * weight of each kept claim is appended to pSHFT for the caller to apply
+ **/
+void GAlot::Retain (const std::function <bool (const Claim&)>& keep) {
+  muint n = 0;
+  pFRWT = pMXWT;
+  for (muint k = 0; k < pCLMS.size(); k++) {
+    if ((pCLMS[k].bdr > -1) && (keep (pCLMS[k]))) {
+      pFRWT -= pCLMS[k].wt;
+      pSHFT.emplace_back (pCLMS[k].bdr, pCLMS[k].wt);
+      pCLMS[n++] = pCLMS[k];
+    }
+  }
+  pCLMS.resize (n);
+  return;
+}
+
 /** --- UpdateClaims -----------------------------------------------------------
+ * the lot does not touch the bidders: their weight changes are appended to
+ * pSHFT, in the order they happen, for the caller to apply
  **/
-void GAlot::UpdateClaim (Claim& C, Object& P, GAbdlst& B) {
+void GAlot::UpdateClaim (Claim& C, Object& P) {
   Claim tmp;
   mfloat df;
   if (pMXWT < C.wt) {
@@ -39,33 +129,33 @@ void GAlot::UpdateClaim (Claim& C, Object& P, GAbdlst& B) {
   df = C.wt - pFRWT;
   while ((df > gEPS) && (C.pr > P.c)) {
     // free up weight
-    auto ri = pCLMS->begin ();
-    if (ri->bdr == C.bdr) {  // Hungry Cannibals rule
-      C.wt += ri->wt;
+    const Claim& ri = pCLMS.back ();
+    if (ri.bdr == C.bdr) {  // Hungry Cannibals rule
+      C.wt += ri.wt;
       if (pMXWT < C.wt) {
         C.wt = pMXWT;
       }
       df = C.wt - pFRWT;
     }
-    if (ri->wt - df > gEPS) {
-      tmp = *ri;
+    if (ri.wt - df > gEPS) {
+      tmp = ri;
       pFRWT = C.wt;
-      if (ri->bdr > -1) {
-        B[muint (ri->bdr)].Pop (df);
+      if (ri.bdr > -1) {
+        pSHFT.emplace_back (ri.bdr, -df);
       }
       tmp.wt -= df;
       df = 0.0;
-      pCLMS->erase (ri);
-      pCLMS->emplace_hint (pCLMS->cbegin(), tmp);
+      pCLMS.pop_back ();
+      Insert (tmp);
     } else {
-      pFRWT += ri->wt;
-      if (ri->bdr > -1) {
-        B[muint (ri->bdr)].Pop (ri->wt);
+      pFRWT += ri.wt;
+      if (ri.bdr > -1) {
+        pSHFT.emplace_back (ri.bdr, -ri.wt);
       }
-      df -= ri->wt;
-      pCLMS->erase (ri);
-      if (!pCLMS->empty ()) {
-        P.c = pCLMS->begin()->pr;
+      df -= ri.wt;
+      pCLMS.pop_back ();
+      if (!pCLMS.empty ()) {
+        P.c = pCLMS.back().pr;
       }
     }
   }
@@ -75,11 +165,11 @@ void GAlot::UpdateClaim (Claim& C, Object& P, GAbdlst& B) {
   if (C.wt > 0) {
     P.i = C.bdr;
     // add claim to dst list
-    pCLMS->emplace_hint (pCLMS->cbegin(), C);
+    Insert (C);
     pFRWT -= C.wt;
-    B[muint (C.bdr)].Push (C.wt);
+    pSHFT.emplace_back (C.bdr, C.wt);
     if (pFRWT < gEPS) {
-      P.c = pCLMS->begin()->pr;
+      P.c = pCLMS.back().pr;
     }
   }
   return;
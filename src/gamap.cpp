@@ -30,9 +30,11 @@ Science Foundation.
 
 /** --- Standard Constructor ---------------------------------------------------
  **/
-GAmap::GAmap (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+GAmap::GAmap (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
               const mfloat MX, const mfloat MN, const mfloat ST)
-  : pEPS (MX), pMN (MN), pSTP (ST)
+  : pEPS (MX), pNB (0), pPOL (std::make_shared <Pool> (gTHR)), pPS (0.0),
+    pSCH (MN, ST, std::accumulate (DWT.begin(), DWT.end(), mfloat (0.0))),
+    pSNE (MX)
 {
   pBDR.clear();
   pCLM.clear();
@@ -49,9 +51,12 @@ GAmap::GAmap (const mfvec& DWT, const mfvec& SWT, const voblist& A,
     for (muint it = 0; it < DWT.size(); it++) {
       pCLM.emplace_back ();
     } 
+    pARC = A;
+    pAIX = ArcIndex (pARC);
+    pBST = mfvec (DWT.size(), 0.0);
     pBDR.reserve (DWT.size());
     for(muint it = 0; it < DWT.size(); it++) {
-      pBDR.emplace_back (it, DWT[it], A[it]);
+      pBDR.emplace_back (it, DWT[it], pARC, it);
       pBDR.back().Refresh (pEPS);
     }
     if (gVBS > 0) {
@@ -65,49 +70,119 @@ GAmap::GAmap (const mfvec& DWT, const mfvec& SWT, const voblist& A,
 }
 
 /** --- Solve ------------------------------------------------------------------
+ * false if the time budget stopped the auction early; T and PR are then the
+ * plan and prices of the last phase completed
  **/
-void GAmap::Solve (objlist& T, mfvec& PR) {
+bool GAmap::Solve (objlist& T, mfvec& PR) {
   T.clear();
   PR.clear();
   if (pBDR.size() > 0) {
+    std::chrono::high_resolution_clock::time_point t1, t2;
+    t1 = std::chrono::high_resolution_clock::now();
     Auction ();
-    PR = mfvec (pPR.size(), 0.0);
-    for (muint it = 0; it < pPR.size(); it++) {
-      PR[muint (pPR[it].j)] = pPR[it].c;
-    }
-    Object O;
-    muint st;
-    bool dup;
-    cllist CL;
-    for (muint j = 0; j < pLTS.size(); j++) {
-      st = T.size();
-      O.j = mint (j);
-      pLTS[j].Export (CL);
-      if (CL.size() == 0) {
-        T.emplace_back (0.0, -1, j);
-      } else {
-        for (auto it = CL.begin(); it != CL.end(); it++) {
-          O.i = it->bdr;
-          O.c = it->wt;
-          dup = false;
-          // test solution for duplicate arc
-          for (muint i = st; i < T.size(); i++) {
-            if (T[i].i == O.i) {
-              dup = true;
-              T[i].c += O.c;
-                i = T.size();
-            }
-          }
-          if (!dup) {
-            T.push_back(O);
-          }
+    t2 = std::chrono::high_resolution_clock::now();
+    if (gVBS > 0) {
+      char str[255];
+      std::chrono::duration <mfloat> dur = t2 - t1;
+      std::sprintf (str,
+                    "  - General auction bids    : %lu bids, %.3e bids/sec",
+                    pNB, mfloat (pNB) / dur.count());
+      std::cout << str << std::endl;
+    }
+    Export (T, PR);
+  }
+  return (!pSCH.Cut());
+}
+
+/** --- SetCost ----------------------------------------------------------------
+ * changes the cost of the arc from bidder i to lot j to c, for an Update;
+ * only the claims of bidder i that the change leaves outside eps-CS are
+ * released, since the best net values of the other bidders do not change
+ **/
+void GAmap::SetCost (const muint i, const muint j, const mfloat c) {
+  if (i < pBDR.size()) {
+    const muint k = pAIX.Find (i, muidx (j));
+    if (k < pAIX.Arcs()) {
+      const mfloat* cs = pARC.Costs();
+      pARC.SetCost (k, c);
+      if (pARC.Costs() != cs) {
+        for (muint n = 0; n < pBDR.size(); n++) {
+          pBDR[n].Rebind (pARC, n);
         }
       }
+      Revise (i);
+    }
+  }
+  return;
+}
+
+/** --- SetDemand --------------------------------------------------------------
+ * changes the weight of bidder i to wt, for an Update; a bidder that now
+ * claims too much gives up the excess from its claims of least net value
+ **/
+void GAmap::SetDemand (const muint i, const mfloat wt) {
+  if ((i < pBDR.size()) && (wt >= 0.0)) {
+    pBDR[i].SetWeight (wt);
+    if (-pBDR[i].Need() > gEPS) {
+      // the arcs of the bidder, by the net value of their lot at its price
+      muvec ord;
+      for (muint k = pARC.Begin (i); k < pARC.End (i); k++) {
+        ord.push_back (k);
+      }
+      std::sort (ord.begin(), ord.end(),
+        [this](const muint a, const muint b) -> bool {
+          return (  pARC.Cost (a) - pPR[pARC.Lot (a)].c
+                  < pARC.Cost (b) - pPR[pARC.Lot (b)].c); });
+      for (muint n = 0; (n < ord.size()) && (-pBDR[i].Need() > gEPS); n++) {
+        GAlot& L = pLTS[pARC.Lot (ord[n])];
+        L.ClearShifts ();
+        L.Release (mint (i), -pBDR[i].Need(),
+                   [](const Claim&) -> bool { return true; });
+        Release (pARC.Lot (ord[n]));
+      }
     }
   }
   return;
 }
 
+/** --- SetSupply --------------------------------------------------------------
+ * changes the weight of lot j to wt, for an Update; a lot that is now over
+ * claimed takes the excess from its lowest claims
+ **/
+void GAmap::SetSupply (const muint j, const mfloat wt) {
+  if ((j < pLTS.size()) && (wt >= 0.0)) {
+    pLTS[j].ClearShifts ();
+    pLTS[j].Resize (wt, pPR[j]);
+    Release (j);
+  }
+  return;
+}
+
+/** --- Update -----------------------------------------------------------------
+ * re-solves after SetCost, SetDemand, or SetSupply: the claims left by the
+ * last solve are kept, and only the bidders that lost weight, or now need
+ * more, bid again, at the last epsilon; with a time budget, a Round given up
+ * leaves those bidders active, and the next Update goes on from there; the
+ * partial plan is not exported, so T and PR keep the last complete plan, and
+ * the result is false
+ **/
+bool GAmap::Update (objlist& T, mfvec& PR) {
+  if (pBDR.empty()) {
+    T.clear();
+    PR.clear();
+    return true;
+  }
+  pSCH.Renew ();
+  if (!Round ()) {
+    pSCH.Halt ();
+    return false;
+  }
+  T.clear();
+  PR.clear();
+  Export (T, PR);
+  return true;
+}
+
 /** --- Auction ----------------------------------------------------------------
  **/
 void GAmap::Auction() {
@@ -115,15 +190,76 @@ void GAmap::Auction() {
     for (auto it = pPR.begin(); it < pPR.end(); it++) {
       it->i  = -1;
     }
-    pEPS *= pSTP;
+    pEPS = pSCH.Next (pEPS);
+    const muint nb = pNB;
     for (muint it = 0; it < pBDR.size(); it++) {
       pBDR[it].Refresh (pEPS);
     }
-    for (muint it = 0; it < pLTS.size(); it++) {
-      pLTS[it].Refresh ();
+    Retain ();
+    if (!Round ()) {
+      pSCH.Halt ();
+      Restore ();
+      break;
+    }
+    Measure (pNB - nb);
+  } while (pSCH.More (pEPS));
+  return;
+}
+
+/** --- Best -------------------------------------------------------------------
+ * finds the best net value pBST of every bidder at the current prices
+ **/
+void GAmap::Best() {
+  muvec ld (pBDR.size() + 1, 0);
+  for (muint n = 0; n < pBDR.size(); n++) {
+    ld[n + 1] = ld[n] + pBDR[n].Load();
+  }
+  pPOL->Split (ld, [this](const muint b, const muint e) {
+    for (muint n = b; n < e; n++) {
+      pBST[n] = pBDR[n].Best (pPR);
     }
-    Round ();
-  } while (pEPS >= pMN);
+  });
+  return;
+}
+
+/** --- Export -----------------------------------------------------------------
+ * gives the plan, one entry for each bidder and lot it claims, and the price
+ * of each lot
+ **/
+void GAmap::Export (objlist& T, mfvec& PR) const {
+  PR = mfvec (pPR.size(), 0.0);
+  for (muint it = 0; it < pPR.size(); it++) {
+    PR[muint (pPR[it].j)] = pPR[it].c;
+  }
+  Object O;
+  muint st;
+  bool dup;
+  clvec CL;
+  for (muint j = 0; j < pLTS.size(); j++) {
+    st = T.size();
+    O.j = mint (j);
+    pLTS[j].Export (CL);
+    if (CL.size() == 0) {
+      T.emplace_back (0.0, -1, j);
+    } else {
+      for (auto it = CL.begin(); it != CL.end(); it++) {
+        O.i = it->bdr;
+        O.c = it->wt;
+        dup = false;
+        // test solution for duplicate arc
+        for (muint i = st; i < T.size(); i++) {
+          if (T[i].i == O.i) {
+            dup = true;
+            T[i].c += O.c;
+              i = T.size();
+          }
+        }
+        if (!dup) {
+          T.push_back(O);
+        }
+      }
+    }
+  }
   return;
 }
 
@@ -133,27 +269,269 @@ mint GAmap::gcd (const mint a, const mint b) const {
   return (b == 0) ? a : gcd (b, a % b);
 }
 
+/** --- Measure ----------------------------------------------------------------
+ * ends a phase: finds the best net value of every bidder, and reports the
+ * phase, with the primal and dual costs of the claims, to pSCH
+ **/
+void GAmap::Measure (const muint nb) {
+  Best ();
+  mfloat pc = 0.0;
+  mfloat dc = 0.0;
+  mfloat ps = 0.0;
+  for (muint j = 0; j < pLTS.size(); j++) {
+    ps += pPR[j].c;
+    for (const Claim& C : pLTS[j].Claims()) {
+      if (C.bdr > -1) {
+        pc += C.wt * Net (muint (C.bdr), j, 0.0);
+        dc += C.wt * (pBST[muint (C.bdr)] + pPR[j].c);
+      }
+    }
+  }
+  pSCH.Phase (pEPS, nb, pBDR.size(), (ps - pPS) / (mfloat (pLTS.size()) * pEPS),
+              pc, dc);
+  pPS = ps;
+  if (pSCH.Timed()) {
+    pSNE = pEPS;
+    pSNL = pLTS;
+    pSNP = pPR;
+  }
+  return;
+}
+
+/** --- Net --------------------------------------------------------------------
+ * net value of lot j at price pr to bidder i, or -gINF if no arc of the bidder
+ * leads to j
+ **/
+mfloat GAmap::Net (const muint i, const muint j, const mfloat pr) const {
+  const muint k = pAIX.Find (i, muidx (j));
+  return (k == pAIX.Arcs()) ? -gINF : pARC.Cost (k) - pr;
+}
+
+/** --- Restore ----------------------------------------------------------------
+ * goes back to the end of the last phase when a phase was given up: the lots
+ * and prices kept by Measure return, with the epsilon of that phase; every
+ * bidder adds up its claims again, and its best net value is found anew
+ **/
+void GAmap::Restore() {
+  pLTS = pSNL;
+  pPR  = pSNP;
+  pEPS = pSNE;
+  for (muint it = 0; it < pBDR.size(); it++) {
+    pBDR[it].Refresh (pEPS);
+  }
+  for (muint j = 0; j < pLTS.size(); j++) {
+    for (const Claim& C : pLTS[j].Claims()) {
+      if (C.bdr > -1) {
+        pBDR[muint (C.bdr)].Push (C.wt);
+      }
+    }
+  }
+  Best ();
+  return;
+}
+
+/** --- Retain -----------------------------------------------------------------
+ * starts a phase from the claims of the last one: a claim is kept while its
+ * net value, at the price it was made, is within pEPS of the best net value of
+ * its bidder (eps-complementary slackness), and is dropped otherwise
+ **/
+void GAmap::Retain() {
+  for (muint j = 0; j < pLTS.size(); j++) {
+    pLTS[j].ClearShifts ();
+    pLTS[j].Retain ([this, j](const Claim& C) -> bool {
+      return !(pBST[muint (C.bdr)] - Net (muint (C.bdr), j, C.pr) > pEPS);
+    });
+    for (const Shift& S : pLTS[j].Shifts()) {
+      pBDR[muint (S.bdr)].Push (S.wt);
+    }
+  }
+  return;
+}
+
+/** --- Revise -----------------------------------------------------------------
+ * releases the claims of bidder i whose net value, at the price they were
+ * made, is no longer within pEPS of its best net value
+ **/
+void GAmap::Revise (const muint i) {
+  pBST[i] = pBDR[i].Best (pPR);
+  for (muint k = pARC.Begin (i); k < pARC.End (i); k++) {
+    const muint j = pARC.Lot (k);
+    const mfloat cs = pARC.Cost (k);
+    pLTS[j].ClearShifts ();
+    pLTS[j].Release (mint (i), gINF, [this, i, cs](const Claim& C) -> bool {
+      return (pBST[i] - (cs - C.pr) > pEPS); });
+    Release (j);
+  }
+  return;
+}
+
 /** --- Round ------------------------------------------------------------------
+ * only the bidders in pACT bid; a bidder that is not active can only become
+ * active again by losing weight, and then joins pACT for the next iteration;
+ * false if the phase was given up at the end of the time budget, which is
+ * checked after each iteration, so that every call makes progress
  **/
-void GAmap::Round() {
-  bool avail = true;
-  muint n;
-  while (avail) {
-    // get new bids
-    for (muint it = 0; it < pBDR.size(); it++) {
-      pBDR[it].MakeBid(pPR, pCLM[it]);
+bool GAmap::Round() {
+  pACT.clear();
+  for (muint it = 0; it < pBDR.size(); it++) {
+    if (pBDR[it].Active()) {
+      pACT.push_back (it);
+    }
+  }
+  while (!pACT.empty()) {
+    const muint na = pACT.size();
+    // get new bids, split over the threads by the work of each bid
+    muvec ld (na + 1, 0);
+    for (muint n = 0; n < na; n++) {
+      ld[n + 1] = ld[n] + pBDR[pACT[n]].Load();
     }
+    pPOL->Split (ld, [this](const muint b, const muint e) {
+      for (muint n = b; n < e; n++) {
+        pBDR[pACT[n]].MakeBid (pPR, pCLM[pACT[n]]);
+      }
+    });
     // select winners from bids
-    for (muint it = 0; it < pCLM.size(); it++) {
+    Resolve (na);
+    // keep the bidders that are still active, in order
+    std::sort (pACT.begin() + mint (na), pACT.end());
+    std::inplace_merge (pACT.begin(), pACT.begin() + mint (na), pACT.end());
+    pACT.erase (std::unique (pACT.begin(), pACT.end()), pACT.end());
+    pACT.erase (std::remove_if (pACT.begin(), pACT.end(),
+      [this](const muint b) -> bool { return !pBDR[b].Active(); }),
+      pACT.end());
+    if ((!pACT.empty()) && (pSCH.Late())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** --- Release ----------------------------------------------------------------
+ * applies the weight the claims of lot j lost, as recorded by the lot
+ **/
+void GAmap::Release (const muint j) {
+  for (const Shift& S : pLTS[j].Shifts()) {
+    pBDR[muint (S.bdr)].Pop (-S.wt);
+  }
+  pLTS[j].ClearShifts ();
+  return;
+}
+
+/** --- Resolve ----------------------------------------------------------------
+ * applies the claims of the first na bidders of pACT; claims on different lots
+ * are independent, so with more than one thread the claims are grouped by lot
+ * (in bidder order within each lot) and the lots are split over the threads;
+ * the weight changes the lots record are then applied to the bidders in
+ * bidder order, exactly as if the claims were taken one at a time
+ **/
+void GAmap::Resolve (const muint na) {
+  if (pPOL->Size() == 1) {
+    for (muint n = 0; n < na; n++) {
+      const muint it = pACT[n];
       if (pCLM[it].dst != -1) {
-        pLTS[muint (pCLM[it].dst)].UpdateClaim
-          (pCLM[it], pPR[muint (pCLM[it].dst)], pBDR);
+        ++pNB;
+        GAlot& L = pLTS[muint (pCLM[it].dst)];
+        L.ClearShifts ();
+        L.UpdateClaim (pCLM[it], pPR[muint (pCLM[it].dst)]);
+        Apply (n, 0, L.Shifts().size());
       }
     }
-    // decide if round is over
-    avail = false;
-    n = pBDR.size();
-    while ((!avail) && (n > 0)) { avail = pBDR[--n].Active(); }
+    return;
+  }
+  muvec ord;
+  for (muint n = 0; n < na; n++) {
+    if (pCLM[pACT[n]].dst != -1) {
+      ++pNB;
+      ord.push_back (n);
+    }
+  }
+  std::stable_sort (ord.begin(), ord.end(),
+    [this](const muint a, const muint b) -> bool {
+      return (pCLM[pACT[a]].dst < pCLM[pACT[b]].dst); });
+  // start of the claims of each lot in ord
+  muvec grp (1, 0);
+  for (muint k = 1; k < ord.size(); k++) {
+    if (pCLM[pACT[ord[k]]].dst != pCLM[pACT[ord[k - 1]]].dst) {
+      grp.push_back (k);
+    }
+  }
+  if (!ord.empty()) {
+    grp.push_back (ord.size());
+  }
+  // the weight changes of claim n are entries bg[n] to en[n] of its lot; a
+  // claim costs far more than one arc of a bid, hence the lower threshold
+  muvec bg (na, 0);
+  muvec en (na, 0);
+  pPOL->Split (grp, [this, &ord, &grp, &bg, &en](const muint b,
+                                                  const muint e) {
+    for (muint g = b; g < e; g++) {
+      const muint j = muint (pCLM[pACT[ord[grp[g]]]].dst);
+      pLTS[j].ClearShifts ();
+      for (muint k = grp[g]; k < grp[g + 1]; k++) {
+        const muint it = pACT[ord[k]];
+        bg[ord[k]] = pLTS[j].Shifts().size();
+        pLTS[j].UpdateClaim (pCLM[it], pPR[j]);
+        en[ord[k]] = pLTS[j].Shifts().size();
+      }
+    }
+  }, muint (1) << 9);
+  for (muint n = 0; n < na; n++) {
+    if (pCLM[pACT[n]].dst != -1) {
+      Apply (n, bg[n], en[n]);
+    }
+  }
+  return;
+}
+
+/** --- Apply ------------------------------------------------------------------
+ * applies entries b to e of the weight changes recorded by the lot of claim
+ * n; bidders that lose weight are added to pACT
+ **/
+void GAmap::Apply (const muint n, const muint b, const muint e) {
+  const shvec& S = pLTS[muint (pCLM[pACT[n]].dst)].Shifts();
+  for (muint k = b; k < e; k++) {
+    if (S[k].wt < 0.0) {
+      pBDR[muint (S[k].bdr)].Pop (-S[k].wt);
+      pACT.push_back (muint (S[k].bdr));
+    } else {
+      pBDR[muint (S[k].bdr)].Push (S[k].wt);
+    }
+  }
+  return;
+}
+
+/** --- Warm -------------------------------------------------------------------
+ * starts from the prices PR and plan T of an earlier solve of a graph with the
+ * same lots: every lot takes its price, and each flow of T becomes a claim at
+ * that price, as far as the weights of the bidder and the lot allow; the first
+ * phase then keeps the claims that satisfy eps-complementary slackness
+ **/
+void GAmap::Warm (const objlist& T, const mfvec& PR) {
+  if ((pBDR.empty()) || (PR.size() != pLTS.size())) {
+    return;
+  }
+  for (muint j = 0; j < pLTS.size(); j++) {
+    pPR[j].c = PR[j];
+  }
+  for (const Object& O : T) {
+    if (   (O.i > -1) && (muint (O.i) < pBDR.size())
+        && (O.j > -1) && (muint (O.j) < pLTS.size())) {
+      GAbid& B = pBDR[muint (O.i)];
+      Claim C (O.i, O.j, pPR[muint (O.j)].c, std::min (O.c, B.Need()));
+      if ((C.wt > gEPS) && (Net (muint (O.i), muint (O.j), 0.0) > -gINF)) {
+        GAlot& L = pLTS[muint (O.j)];
+        L.ClearShifts ();
+        L.UpdateClaim (C, pPR[muint (O.j)]);
+        for (const Shift& S : L.Shifts()) {
+          B.Push (S.wt);
+        }
+      }
+    }
+  }
+  Best ();
+  pPS = 0.0;
+  for (muint j = 0; j < pLTS.size(); j++) {
+    pPS += pPR[j].c;
   }
   return;
 }
@@ -26,70 +26,115 @@ those of the author and do not necessarily reflect the views of the National
 Science Foundation.
 ---------------------------------------------------------------------------- **/
 
-#include <algorithm>   // std::find
+#include <algorithm>   // std::find, std::max, std::min
 #include <chrono>      // std::chrono::duration, std::chrono::duration_cast,
                        //   std::chrono::high_resolution_clock::now,
                        //   std::chrono::high_resolution_clock::time_point
 #include <cmath>       // std::abs, std::sqrt
-#include <cstdlib>     // exit, EXIT_FAILURE
+#include <cstdlib>     // exit, EXIT_FAILURE, std::strtod, std::strtol
 #include <cstdio>      // std::sprintf
-#include <fstream>     // std::ifstream, std::ofstream
+#include <cstring>     // std::memchr, std::memcmp, std::memcpy, std::strlen,
+                       //   std::strncmp
+#include <fstream>     // std::ofstream
 #include <iostream>    // std::cout, std::endl, std::ios::out, std::ios::trunc
 #include <limits>      // std::numeric_limits
+#include <memory>      // std::shared_ptr
 #include <random>      // std::mt19937_64, std::uniform_int_distribution
-#include <sstream>     // std::stringstream
-#include <string>      // std::string, std::getline
+#include <string>      // std::string
 #include <vector>      // std::vector
-#include "glob.hpp"    // mfloat, mfvec, mint, muint
-#include "object.hpp"  // objlist, voblist
+#include "glob.hpp"    // mfloat, mfvec, mint, muint, muvec
+#include "object.hpp"  // objlist
+#include "arcindex.hpp"  // ArcIndex
+#include "arcset.hpp"  // ArcSet
+#include "bidscan.hpp"  // ScanKernel
+#include "bufout.hpp"  // BufOut
+#include "gbin.hpp"    // GBinCheck, GBinFits, GBinHead, GBIN_MAGIC
+#include "mfile.hpp"   // MFile
+#include "pool.hpp"    // Pool
 #include "apmap.hpp"   // APmap
 #include "gamap.hpp"   // GAmap
 #include "sopmap.hpp"  // SOPmap
 #include "somap.hpp"   // SOmap
 
+bool   gADP = false;  // adaptive epsilon schedule
+bool   gASY = false;  // asynchronous (Gauss-Seidel) AP and SO auctions
 mfloat gEPS = std::sqrt(std::numeric_limits<mfloat>::epsilon());
+mfloat gGAP = 0.0;  // relative duality gap tolerance (0: none)
 mfloat gINF = std::numeric_limits<mfloat>::infinity();
+muint  gTHR = 1;  // number of threads
+mfloat gTME = 0.0;  // time budget of each auction in seconds (0: none)
 muint  gVBS = 0;  // verbosity (0, 1, or 2)
 
-void APrun (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+struct Token {
+  const char* s;  // first character of the token
+  muint       n;  // length of the token
+};
+
+void APrun (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
             const mfloat MX, const mfloat MN, const mfloat ST,
-            objlist& T, mfvec& PR);
-void GArun (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+            const objlist& W, const mfvec& WP, objlist& T, mfvec& PR);
+void GArun (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
             const mfloat MX, const mfloat MN, const mfloat ST,
-            objlist& T, mfvec& PR);
-void SOPrun (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+            const objlist& W, const mfvec& WP, objlist& T, mfvec& PR);
+void SOPrun (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
              const mfloat MX, const mfloat MN, const mfloat ST,
              objlist& T, mfvec& PR);
-void SOrun (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+void SOrun (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
             const mfloat MX, const mfloat MN, const mfloat ST,
-            objlist& T, mfvec& PR);
-mfloat Dual (const mfvec& DWT, const mfvec& SWT, const voblist& ARX,
+            const objlist& W, const mfvec& WP, objlist& T, mfvec& PR);
+mfloat Dual (const mfvec& DWT, const mfvec& SWT, const ArcSet& ARX,
              const mfvec& PR);
-mfloat Primal (const char* aname, const voblist& ARX, const objlist& T);
+mfloat Primal (const char* aname, const ArcSet& ARX, const ArcIndex& AIX,
+              const objlist& T);
 char* GetOption (char ** begin, char ** end, const std::string & option);
 char** GetOptionList (char ** begin, char ** end, const std::string & option,
                       const muint cnt);
+bool Match (const Token& t, const char* w);
 bool OptionExists (char** begin, char** end, const std::string& option);
-muint ReadFile (const char* fname, mfvec& DWT, mfvec& SWT,
-                voblist& ARX, voblist& RARX);
-void Split (const std::string &s, std::vector<std::string> &elms);
-void Split (const std::string &s, char dlm, std::vector<std::string> &elms);
+muint ReadBinary (const std::shared_ptr <MFile>& f, mfvec& DWT, mfvec& SWT,
+                  ArcSet& ARX);
+muint ReadFile (const char* fname, mfvec& DWT, mfvec& SWT, ArcSet& ARX);
+bool ReadWarm (const char* fname, const mfvec& DWT, const mfvec& SWT,
+               objlist& T, mfvec& PR);
+bool ScanArcs (const char*& p, const char* e, const bool rev,
+               const muint NSINK, const muint NSORC, ArcSet& ARX);
+bool ScanFloat (const Token& t, mfloat& v);
+bool ScanUInt (const Token& t, muint& v);
+muint Tokens (const char*& p, const char* e, Token* T, const muint mx);
+int  WriteBinary (const char* fname, const muint seed, const mfvec& DWT,
+                  const mfvec& SWT, const ArcSet& ARX);
 int  WriteFile (const char* fname, const muint seed, const mfvec& DWT,
-                const mfvec& SWT, const voblist& ARX, const objlist& T);
+                const mfvec& SWT, const ArcSet& ARX, const ArcIndex& AIX,
+                const objlist& T);
+int  WriteWarm (const char* fname, const mfvec& DWT, const mfvec& SWT,
+                const objlist& T, const mfvec& PR);
 
 /** --- main -------------------------------------------------------------------
  * program flags:
  *   -a   : perform assignment auction
+ *   -b S : save graph in binary format to file S (without -a, -g, -o, or -p,
+ *            convert the graph and exit)
+ *   -e   : adaptive epsilon schedule, from the statistics of each phase
  *   -g   : perform general auction
- *   -l S : load and process graph file S
+ *   -gap # : stop after the first phase whose relative duality gap is below #
+ *            [requires # > 0]
+ *   -j # : number of threads [requires # > 0]
+ *   -l S : load and process graph file S (text or binary format)
  *   -m # : maximum auction step size [requires # > 0]
  *   -n # : minimum auction step size [requires # > 0]
  *   -o   : perform extended (SO) auction
  *   -p   : perform extended (SOP) auction
  *   -r # : step size scaling rate [requires value 0 < # < 1]
  *   -s S : save graph results file S
+ *   -t # : time budget of each auction in seconds; once it is spent, return the
+ *            plan of the last completed phase [requires # > 0]
+ *   -u S : warm start the -a, -g, and -o auctions from the prices and plan in
+ *            file S, written by -w for a graph with the same nodes
  *   -v   : verbose output
  *   -vv  : very verbose output
+ *   -w S : save the final prices and plan of the first -g, -a, or -o auction
+ *            to warm-start file S
+ *   -y   : asynchronous (Gauss-Seidel) bidding in the -a and -o auctions
  **/
 
 int main (int argc, char *argv[])
@@ -105,12 +150,18 @@ int main (int argc, char *argv[])
   bool    wr = false;
   bool    xo = false;
   bool    xp = false;
+  bool    ww = false;
   mfvec DWT, SWT;
-  voblist ARX, RARX;
+  ArcSet ARX;
+  objlist W;     // warm-start plan
+  mfvec   WP;    // warm-start prices
   // Implement option flags
   if (OptionExists(argv, argv+argc, "-a")) {
     ap = true;
   }
+  if (OptionExists(argv, argv+argc, "-e")) {
+    gADP = true;
+  }
   if (OptionExists(argv, argv+argc, "-g")) {
     ga = true;
   }
@@ -125,14 +176,40 @@ int main (int argc, char *argv[])
   } else if (OptionExists(argv, argv+argc, "-v")) {
     gVBS = 1;
   }
+  if (OptionExists(argv, argv+argc, "-y")) {
+    gASY = true;
+  }
+  char* gpstr = GetOption(argv, argv + argc, "-gap");
+  if (gpstr != 0) {
+    if (std::strtod (gpstr, nullptr) > 0.0) {
+      gGAP = std::strtod (gpstr, nullptr);
+    }
+  }
+  char* tmstr = GetOption(argv, argv + argc, "-t");
+  if (tmstr != 0) {
+    if (std::strtod (tmstr, nullptr) > 0.0) {
+      gTME = std::strtod (tmstr, nullptr);
+    }
+  }
+  char* thstr = GetOption(argv, argv + argc, "-j");
+  if (thstr != 0) {
+    if (std::strtol (thstr, nullptr, 10) > 0) {
+      gTHR = muint (std::strtol (thstr, nullptr, 10));
+    }
+  }
+  std::chrono::high_resolution_clock::time_point t1, t2;
+  std::chrono::duration <mfloat> dur;
   char* fname = GetOption(argv, argv + argc, "-l");
+  t1 = std::chrono::high_resolution_clock::now();
   if (fname != 0) {
-    seed = ReadFile (fname, DWT, SWT, ARX, RARX);
+    seed = ReadFile (fname, DWT, SWT, ARX);
   }
+  t2 = std::chrono::high_resolution_clock::now();
   if (seed == 0) {
     std::cout << "Error opening file" << std::endl;
     exit (EXIT_FAILURE);
   }
+  dur = std::chrono::duration_cast <std::chrono::duration <mfloat> > (t2 - t1);
   char* sname = GetOption(argv, argv + argc, "-s");
   if (sname != 0) {
     wr = true;
@@ -156,41 +233,67 @@ int main (int argc, char *argv[])
       stp = std::strtod (rpstr, nullptr);
     }
   }
-  if ((!ap) && (!ga) && (!xo) && (!xp)) {
+  char* wname = GetOption(argv, argv + argc, "-w");
+  if (wname != 0) {
+    ww = true;
+  }
+  char* uname = GetOption(argv, argv + argc, "-u");
+  if (uname != 0) {
+    if (!ReadWarm (uname, DWT, SWT, W, WP)) {
+      std::cout << "Error reading warm-start file" << std::endl;
+      exit (EXIT_FAILURE);
+    }
+  }
+  char* bname = GetOption(argv, argv + argc, "-b");
+  if ((!ap) && (!ga) && (!xo) && (!xp) && (bname == 0)) {
     ga = true;
   }
   mfloat C = 0;
-  muint  ar = 0;
-  for (muint i = 0; i < ARX.size(); i++) {
-    for (muint j = 0; j < ARX[i].size(); j++) {
-      ar++;
-      if (C < std::abs(ARX[i][j].c)) {
-        C = std::abs(ARX[i][j].c);
-      }
+  muint  ar = ARX.Arcs();
+  for (muint k = 0; k < ar; k++) {
+    if (C < std::abs(ARX.Cost (k))) {
+      C = std::abs(ARX.Cost (k));
     }
   }
-  if (eps < gEPS) {
-    eps = C / 5.0;
-  }
   if (min < gEPS) {
     min = 1.0 / mfloat (SWT.size());
   }
+  mfloat ceps = eps;  // starting epsilon without warm start (SOP)
+  if (eps < gEPS) {
+    ceps = C / 5.0;
+    // the warm-start prices are already close: start two steps above min
+    eps = (WP.empty()) ? ceps : min / (stp * stp);
+  }
   objlist T;     // transport plan
   mfvec   PR;    // price vector
   mfloat  pcst;  // primal cost
   mfloat  dcst;  // dual cost
-  std::chrono::high_resolution_clock::time_point t1, t2;
-  std::chrono::duration <mfloat> dur;
   std::sprintf (str, "  GRAPH: %lu sinks, %lu sources, %lu arcs", DWT.size(),
                 SWT.size(), ar);
   std::cout << str << std::endl;
+  std::sprintf (str, "  LOAD : %.3f sec", dur.count());
+  std::cout << str << std::endl;
+  if (gVBS > 0) {
+    std::sprintf (str, "  SIMD : %s bid scans", ScanKernel());
+    std::cout << str << std::endl;
+  }
+  if (bname != 0) {
+    err = WriteBinary (bname, seed, DWT, SWT, ARX);
+    if (err != 0) {
+      std::cout << "Error writing binary file" << std::endl;
+    }
+    if ((!ap) && (!ga) && (!xo) && (!xp)) {
+      return err;
+    }
+  }
+  ArcIndex AIX (ARX);  // arc lookup for the transport plans
   std::sprintf (str, "  EPS  : %f starting, %e minimum", eps, min);
   std::cout << str << std::endl;
   std::cout << "  ----------------------------------------------------------"
             << std::endl;
   if (ga) {
     t1 = std::chrono::high_resolution_clock::now();
-    GArun (DWT, SWT, ARX, eps, min, stp, T, PR);
+    GArun (DWT, SWT, ARX, eps, min, stp, W, WP, T, PR);
     t2 = std::chrono::high_resolution_clock::now();
     dur = std::chrono::duration_cast <std::chrono::duration <mfloat> >
       (t2 - t1);
@@ -198,7 +301,7 @@ int main (int argc, char *argv[])
       std::sprintf (str, "  General auction NOT SOLVED");
       std::cout << str << std::endl;
     } else {
-      pcst = Primal ("GA", ARX, T);
+      pcst = Primal ("GA", ARX, AIX, T);
       std::sprintf (str, "  General auction primal cost    : %25.15f", pcst);
       std::cout <<  str << std::endl;
       dcst = Dual (DWT, SWT, ARX, PR);
@@ -214,13 +317,17 @@ int main (int argc, char *argv[])
     std::cout << "  ----------------------------------------------------------"
               << std::endl;
     if (wr) {
-      err = WriteFile (sname, seed, DWT, SWT, ARX, T);
+      err = WriteFile (sname, seed, DWT, SWT, ARX, AIX, T);
       wr = false;
     }
+    if ((ww) && (!T.empty())) {
+      err = WriteWarm (wname, DWT, SWT, T, PR);
+      ww = false;
+    }
   }
   if (ap) {
     t1 = std::chrono::high_resolution_clock::now();
-    APrun (DWT, SWT, ARX, eps, min, stp, T, PR);
+    APrun (DWT, SWT, ARX, eps, min, stp, W, WP, T, PR);
     t2 = std::chrono::high_resolution_clock::now();
     dur = std::chrono::duration_cast <std::chrono::duration <mfloat> >
       (t2 - t1);
@@ -228,7 +335,7 @@ int main (int argc, char *argv[])
       std::sprintf (str, "  Assignment auction NOT SOLVED");
       std::cout << str << std::endl;
     } else {
-      pcst = Primal ("AP", ARX, T);
+      pcst = Primal ("AP", ARX, AIX, T);
       std::sprintf (str, "  Assignment auction primal cost : %25.15f", pcst);
       std::cout <<  str << std::endl;
       dcst = Dual (DWT, SWT, ARX, PR);
@@ -244,13 +351,17 @@ int main (int argc, char *argv[])
     std::cout << "  ----------------------------------------------------------"
               << std::endl;
     if (wr) {
-      err = WriteFile (sname, seed, DWT, SWT, ARX, T);
+      err = WriteFile (sname, seed, DWT, SWT, ARX, AIX, T);
       wr = false;
     }
+    if ((ww) && (!T.empty())) {
+      err = WriteWarm (wname, DWT, SWT, T, PR);
+      ww = false;
+    }
   }
   if (xo) {
     t1 = std::chrono::high_resolution_clock::now();
-    SOrun (DWT, SWT, ARX, eps, min, stp, T, PR);
+    SOrun (DWT, SWT, ARX, eps, min, stp, W, WP, T, PR);
     t2 = std::chrono::high_resolution_clock::now();
     dur = std::chrono::duration_cast <std::chrono::duration <mfloat> >
       (t2 - t1);
@@ -258,7 +369,7 @@ int main (int argc, char *argv[])
       std::sprintf (str, "  AUCTION-SO NOT SOLVED");
       std::cout << str << std::endl;
     } else {
-      pcst = Primal ("SO", ARX, T);
+      pcst = Primal ("SO", ARX, AIX, T);
       std::sprintf (str, "  AUCTION-SO primal cost         : %25.15f", pcst);
       std::cout <<  str << std::endl;
       dcst = Dual (DWT, SWT, ARX, PR);
@@ -274,14 +385,19 @@ int main (int argc, char *argv[])
     std::cout << "  ----------------------------------------------------------"
               << std::endl;
     if (wr) {
-      err = WriteFile (sname, seed, DWT, SWT, ARX, T);
+      err = WriteFile (sname, seed, DWT, SWT, ARX, AIX, T);
       wr = false;
     }
+    if ((ww) && (!T.empty())) {
+      err = WriteWarm (wname, DWT, SWT, T, PR);
+      ww = false;
+    }
   }
   if (xp) {
     objlist S;
     t1 = std::chrono::high_resolution_clock::now();
-    SOPrun (SWT, DWT, RARX, eps, min, stp, S, PR);
+    // only SOP bids from the supply side, over the transposed arcs
+    SOPrun (SWT, DWT, ARX.Transpose (SWT.size()), ceps, min, stp, S, PR);
     t2 = std::chrono::high_resolution_clock::now();
     dur = std::chrono::duration_cast <std::chrono::duration <mfloat> >
       (t2 - t1);
@@ -293,7 +409,7 @@ int main (int argc, char *argv[])
       for (muint it = 0; it < S.size(); it++) {
         T.emplace_back (S[it].c, S[it].j, S[it].i);
       }
-      pcst = Primal ("SOP", ARX, T);
+      pcst = Primal ("SOP", ARX, AIX, T);
       std::sprintf (str, "  AUCTION-SOP primal cost        : %25.15f", pcst);
       std::cout <<  str << std::endl;
       dcst = Dual (DWT, SWT, ARX, PR);
@@ -309,7 +425,7 @@ int main (int argc, char *argv[])
     std::cout << "  ----------------------------------------------------------"
               << std::endl;
     if (wr) {
-      err = WriteFile (sname, seed, DWT, SWT, ARX, T);
+      err = WriteFile (sname, seed, DWT, SWT, ARX, AIX, T);
       wr = false;
     }
   }
@@ -318,27 +434,33 @@ int main (int argc, char *argv[])
 
 /** --- APrun ------------------------------------------------------------------
  **/
-void APrun (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+void APrun (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
             const mfloat MX, const mfloat MN, const mfloat ST,
-            objlist& T, mfvec& PR) {
+            const objlist& W, const mfvec& WP, objlist& T, mfvec& PR) {
   APmap apslv (DWT, SWT, A, MX, MN, ST);
+  if (!WP.empty()) {
+    apslv.Warm (W, WP);
+  }
   apslv.Solve (T, PR);
   return;
 }
 
 /** --- GArun ------------------------------------------------------------------
  **/
-void GArun (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+void GArun (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
             const mfloat MX, const mfloat MN, const mfloat ST,
-            objlist& T, mfvec& PR) {
+            const objlist& W, const mfvec& WP, objlist& T, mfvec& PR) {
   GAmap gslv (DWT, SWT, A, MX, MN, ST);
+  if (!WP.empty()) {
+    gslv.Warm (W, WP);
+  }
   gslv.Solve (T, PR);
   return;
 }
 
 /** --- SOPrun -----------------------------------------------------------------
  **/
-void SOPrun (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+void SOPrun (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
              const mfloat MX, const mfloat MN, const mfloat ST,
              objlist& T, mfvec& PR) {
   SOPmap sopslv (DWT, SWT, A, MX, MN, ST);
@@ -348,28 +470,32 @@ void SOPrun (const mfvec& DWT, const mfvec& SWT, const voblist& A,
 
 /** --- SOrun -----------------------------------------------------------------
  **/
-void SOrun (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+void SOrun (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
             const mfloat MX, const mfloat MN, const mfloat ST,
-            objlist& T, mfvec& PR) {
+            const objlist& W, const mfvec& WP, objlist& T, mfvec& PR) {
   SOmap soslv (DWT, SWT, A, MX, MN, ST);
+  if (!WP.empty()) {
+    soslv.Warm (W, WP);
+  }
   soslv.Solve (T, PR);
   return;
 }
 
 /** --- Dual -------------------------------------------------------------------
  **/
-mfloat Dual (const mfvec& DWT, const mfvec& SWT, const voblist& ARX,
+mfloat Dual (const mfvec& DWT, const mfvec& SWT, const ArcSet& ARX,
              const mfvec& PR) {
   mfloat dcst = 0.0;
   mfvec  M;
   char   str[255];
   for (muint i = 0; i < DWT.size(); i++) {
     M.clear();
-    for (muint j = 0; j < ARX[i].size(); j++) {
-      M.push_back (ARX[i][j].c - PR[muint (ARX[i][j].j)]);
+    for (muint k = ARX.Begin (i); k < ARX.End (i); k++) {
+      M.push_back (ARX.Cost (k) - PR[ARX.Lot (k)]);
       if (gVBS > 1) {
-        std::sprintf (str, " Exp %lu -> %lu : %f - %f = %f", i, j,
-                      ARX[i][j].c, PR[muint (ARX[i][j].j)], M.back());
+        std::sprintf (str, " Exp %lu -> %lu : %f - %f = %f", i,
+                      k - ARX.Begin (i), ARX.Cost (k), PR[ARX.Lot (k)],
+                      M.back());
         std::cout << str << std::endl;
       }
     }
@@ -393,21 +519,18 @@ mfloat Dual (const mfvec& DWT, const mfvec& SWT, const voblist& ARX,
 
 /** --- Primal -----------------------------------------------------------------
  **/
-mfloat Primal (const char* aname, const voblist& ARX, const objlist& T) {
+mfloat Primal (const char* aname, const ArcSet& ARX, const ArcIndex& AIX,
+              const objlist& T) {
   mfloat pcst = 0.0;
   muint  tst;
   char   str[255];
   for (muint it = 0; it < T.size(); it++) {
-    tst = 0;
-    while (   (tst < ARX[muint (T[it].i)].size())
-           && (ARX[muint (T[it].i)][tst].j != T[it].j)) {
-      tst++;
-    }
-    if (tst < ARX[muint (T[it].i)].size()) {
-      pcst += ARX[muint (T[it].i)][tst].c * T[it].c;
+    tst = AIX.Find (muint (T[it].i), muidx (T[it].j));
+    if (tst < AIX.Arcs()) {
+      pcst += ARX.Cost (tst) * T[it].c;
       if (gVBS > 1) {
         std::sprintf (str, "    %3ld -> %3ld : %f @ %f ", T[it].j, T[it].i,
-                      T[it].c, ARX[muint (T[it].i)][tst].c);
+                      T[it].c, ARX.Cost (tst));
         std::cout << str << std::endl;
       }
     } else {
@@ -450,180 +573,156 @@ bool OptionExists (char** begin, char** end, const std::string& option) {
   return std::find(begin, end, option) != end;
 }
 
-/** --- Split ------------------------------------------------------------------
+/** --- Match ------------------------------------------------------------------
  **/
-void Split (const std::string &s, std::vector<std::string> &elms) {
-  Split (s, ' ', elms);
-  return;
+bool Match (const Token& t, const char* w) {
+  return ((t.n == std::strlen (w)) && (std::strncmp (t.s, w, t.n) == 0));
 }
 
-/** --- Split ------------------------------------------------------------------
+/** --- ReadBinary -------------------------------------------------------------
+ * the arc arrays of ARX are used directly from the mapped file f
  **/
-void Split (const std::string &s, char dlm, std::vector<std::string> &elms) {
-  elms.clear();
-  std::stringstream ss(s);
-  std::string itm;
-  while (std::getline(ss, itm, dlm)) {
-    if (!itm.empty()) {
-      elms.push_back(itm);
+muint ReadBinary (const std::shared_ptr <MFile>& f, mfvec& DWT, mfvec& SWT,
+                  ArcSet& ARX) {
+  static_assert (sizeof (muint) == 8, "binary graphs need 64-bit offsets");
+  GBinHead H;
+  std::memcpy (&H, f->Data(), sizeof (GBinHead));
+  if ((!GBinCheck (H)) || (!GBinFits (H, f->Size())) || (H.nrow == 0)) {
+    return 0;
+  }
+  const char*   p   = f->Data() + sizeof (GBinHead);
+  const mfloat* dwt = reinterpret_cast <const mfloat*> (p);
+  const mfloat* swt = dwt + H.nrow;
+  const muint*  ofs = reinterpret_cast <const muint*> (swt + H.ncol);
+  const mfloat* cst = reinterpret_cast <const mfloat*> (ofs + H.nrow + 1);
+  const muidx*  lot = reinterpret_cast <const muidx*> (cst + H.narc);
+  if ((ofs[0] != 0) || (ofs[H.nrow] != H.narc)) {
+    return 0;
+  }
+  for (muint it = 0; it < H.nrow; it++) {
+    if (ofs[it] > ofs[it+1]) {
+      return 0;
     }
   }
-  return;
+  for (muint k = 0; k < H.narc; k++) {
+    if (lot[k] >= H.ncol) {
+      return 0;
+    }
+  }
+  DWT.assign (dwt, dwt + H.nrow);
+  SWT.assign (swt, swt + H.ncol);
+  ARX  = ArcSet (ofs, lot, cst, H.nrow, f);
+  return H.seed;
 }
 
 /** --- ReadFile ---------------------------------------------------------------
+ * the file is memory-mapped; binary graphs are recognized by their header,
+ * and text graphs are parsed in place, without building strings
  **/
-muint ReadFile (const char* fname, mfvec& DWT, mfvec& SWT, voblist& ARX,
-                voblist& RARX) {
-  mfloat AMT;    // individual node weight
-  mfloat CST;    // individual arc cost
-//   mfloat FLW;    // individual arc flow
-  muint  I;      // individual node id
-//   muint  IARCS;  // number of arcs
-  muint  IH;     // individual arc head
-  muint  ISEED;  // random number seed
-  muint  IT;     // individual arc tail
-//   mfloat ITSUP;  // total supply
-  muint  NSINK;  // total number of sink nodes
-  muint  NSORC;  // total number of source nodes
+muint ReadFile (const char* fname, mfvec& DWT, mfvec& SWT, ArcSet& ARX) {
+  mfloat AMT;        // individual node weight
+  muint  I;          // individual node id
+  muint  ISEED = 0;  // random number seed
+  muint  NSINK = 0;  // total number of sink nodes
+  muint  NSORC = 0;  // total number of source nodes
+  Token  T[9];       // tokens of the current line
+  muint  nt;         // number of tokens on the current line
   bool good = false;
   bool rev  = false;
-  ARX.clear ();
+  ARX  = ArcSet ();
   SWT.clear ();
   DWT.clear ();
-  std::ifstream f (fname);
-  if (f.is_open()) {
-    std::string line;
-    if (std::getline (f, line)) {
-      std::vector<std::string> elms;  
-      Split (line, elms);
-      if (!elms.empty()) {
-        bool  cont = true;
-        muint ctr  = 1;
-        muint pos  = 0;
-        if (elms.size() == 1) {
-          if (elms[0].compare ("BEGIN") == 0) {
-            while ((cont) && (std::getline (f, line))) {
-              cont = false;
-              Split (line, elms);
-              switch (pos) {
-                case 0:
-                  if ((elms.size() == 8) &&
-                      (elms[0].compare ("GRAPH") == 0)) {
-                    ISEED  = std::stoul (elms[1], nullptr, 10);
-                    if (elms[2].compare ("WITH") == 0) {
-                      NSINK  = std::stoul (elms[3], nullptr, 10);
-                      if (   (elms[4].compare ("SINKS") == 0)
-                          && (elms[5].compare ("AND") == 0)) {
-                        NSORC  = std::stoul (elms[6], nullptr, 10);
-                        if (elms[7].compare ("SOURCES") == 0) {
-                          cont = true;
-                          pos = 1;
-                          if (NSORC > NSINK) {
-                            rev = true;
-                            DWT.reserve (NSORC);
-                            SWT.reserve (NSINK);
-                            ARX.resize (NSORC);
-                            RARX.resize (NSINK);
-                          } else {
-                            DWT.reserve (NSINK);
-                            SWT.reserve (NSORC);
-                            ARX.resize (NSINK);
-                            RARX.resize (NSORC);
-                          }
-                        }
-                      }
-                    }
-                  }
-                  break;
-                case 1:
-                  if (elms.size() == 6) {
-                    // IARCS = std::stoul (elms[0], nullptr, 10); // UNUSED
-                    if (   (elms[1].compare ("ARCS") == 0)
-                        && (elms[2].compare ("AND") == 0)) {
-                      // ITSUP  = std::stod  (elms[3], nullptr); // UNUSED
-                      if ((elms[4].compare ("TOTAL") == 0)
-                          && (elms[5].compare ("WEIGHT") == 0)) {
-                        cont = true;
-                        pos = 2;
-                      }
-                    }
-                  }
-                case 2:
-                  if ((elms.size() == 1) && (elms[0].compare ("DEMAND") == 0)) {
-                    cont = true;
-                    pos = 3;
-                  }
-                  break;
-                case 3:
-                  if (elms.size() == 1) {
-                    if (elms[0].compare ("ARCS") == 0) {
-                      cont = true;
-                      pos = 4;
-                    }
-                  } else if (elms.size() == 2) {
-                    I = std::stoul (elms[0], nullptr, 10);
-                    if (I == ctr) {
-                      AMT = std::stod (elms[1], nullptr);
-                      if (rev) {
-                        SWT.push_back(AMT);
-                      } else {
-                        DWT.push_back(AMT);
-                      }
-                      cont = true;
-                      ctr++;
-                    }
-                  }
-                  break;
-                case 4:
-                  if (elms.size() == 1) {
-                    if (elms[0].compare ("SUPPLY") == 0) {
-                      cont = true;
-                      pos = 5;
-                    }
-                  } else if (elms.size() == 4) {
-                    IT  = std::stoul (elms[0], nullptr, 10);
-                    IH  = std::stoul (elms[1], nullptr, 10);
-                    CST = std::stod  (elms[2], nullptr);
-                    // FLW = std::stod  (elms[3], nullptr); // UNUSED
-                    if (rev) {
-                      ARX[IH-NSINK-1].emplace_back (CST, IH-NSINK-1, IT-1);
-                      RARX[IT-1].emplace_back (CST, IT-1, IH-NSINK-1);
-                    } else {
-                      ARX[IT-1].emplace_back (CST, IT-1, IH-NSINK-1);
-                      RARX[IH-NSINK-1].emplace_back (CST, IH-NSINK-1, IT-1);
-                    }
-                    cont = true;
-                  }
-                  break;
-                case 5:
-                  if (elms.size() == 1) {
-                    if (elms[0].compare ("END") == 0) {
-                      good = true;
-                    }
-                  } else if (elms.size() == 2) {
-                    I = std::stoul (elms[0], nullptr, 10);
-                    if (I == ctr) {
-                      AMT = std::stod (elms[1], nullptr);
-                      if (rev) {
-                        DWT.push_back(AMT);
-                      } else {
-                        SWT.push_back(AMT);
-                      }
-                      cont = true;
-                      ctr++;
-                    }
-                  }
-                  break;
-                default:
-                  break;
+  std::shared_ptr <MFile> f (new MFile (fname));
+  if (f->Good()) {
+    const char* p = f->Data();
+    const char* e = p + f->Size();
+    if (   (f->Size() >= sizeof (GBinHead))
+        && (std::memcmp (p, GBIN_MAGIC, sizeof (GBIN_MAGIC)) == 0)) {
+      return ReadBinary (f, DWT, SWT, ARX);
+    }
+    if ((Tokens (p, e, T, 9) == 1) && (Match (T[0], "BEGIN"))) {
+      bool  cont = true;
+      muint ctr  = 1;
+      muint pos  = 0;
+      while ((cont) && (p < e)) {
+        cont = false;
+        nt = Tokens (p, e, T, 9);
+        switch (pos) {
+          case 0:
+            if (   (nt == 8) && (Match (T[0], "GRAPH"))
+                && (ScanUInt (T[1], ISEED)) && (Match (T[2], "WITH"))
+                && (ScanUInt (T[3], NSINK)) && (Match (T[4], "SINKS"))
+                && (Match (T[5], "AND")) && (ScanUInt (T[6], NSORC))
+                && (Match (T[7], "SOURCES"))) {
+              cont = true;
+              pos = 1;
+              if (NSORC > NSINK) {
+                rev = true;
+                DWT.reserve (NSORC);
+                SWT.reserve (NSINK);
+              } else {
+                DWT.reserve (NSINK);
+                SWT.reserve (NSORC);
               }
             }
-          }
+            break;
+          case 1:
+            if (   (nt == 6) && (Match (T[1], "ARCS"))
+                && (Match (T[2], "AND")) && (Match (T[4], "TOTAL"))
+                && (Match (T[5], "WEIGHT"))) {
+              cont = true;
+              pos = 2;
+            }
+            break;
+          case 2:
+            if ((nt == 1) && (Match (T[0], "DEMAND"))) {
+              cont = true;
+              pos = 3;
+            }
+            break;
+          case 3:
+            if (nt == 1) {
+              if (Match (T[0], "ARCS")) {
+                // consumes the arc lines and the SUPPLY line that ends them
+                cont = ScanArcs (p, e, rev, NSINK, NSORC, ARX);
+                pos = 4;
+              }
+            } else if (nt == 2) {
+              if (   (ScanUInt (T[0], I)) && (I == ctr)
+                  && (ScanFloat (T[1], AMT))) {
+                if (rev) {
+                  SWT.push_back(AMT);
+                } else {
+                  DWT.push_back(AMT);
+                }
+                cont = true;
+                ctr++;
+              }
+            }
+            break;
+          case 4:
+            if (nt == 1) {
+              if (Match (T[0], "END")) {
+                good = true;
+              }
+            } else if (nt == 2) {
+              if (   (ScanUInt (T[0], I)) && (I == ctr)
+                  && (ScanFloat (T[1], AMT))) {
+                if (rev) {
+                  DWT.push_back(AMT);
+                } else {
+                  SWT.push_back(AMT);
+                }
+                cont = true;
+                ctr++;
+              }
+            }
+            break;
+          default:
+            break;
         }
       }
     }
-    f.close();
   }
   if (!good) {
     ISEED = 0;
@@ -631,97 +730,423 @@ muint ReadFile (const char* fname, mfvec& DWT, mfvec& SWT, voblist& ARX,
   return ISEED;
 }
 
-/** --- WriteFile --------------------------------------------------------------
+/** --- ReadWarm ---------------------------------------------------------------
+ * reads a warm-start file written by WriteWarm for a graph with the sizes of
+ * DWT and SWT; the indices are those of the graph file
  **/
-int WriteFile (const char* fname, const muint seed, const mfvec& DWT,
-               const mfvec& SWT, const voblist& ARX, const objlist& T) {
-  int    err = 0;
-  muint  arc = 0;
-  mfloat twt = 0.0;
-  muint  tst;
-  char  str[255];
-  std::vector <mfvec> FL (DWT.size());
-  std::ofstream f (fname, std::ios::out | std::ios::trunc);
-  if (f.is_open()) {
-    f << "BEGIN" << std::endl;
-    for (muint i = 0; i < ARX.size(); i++) {
-      arc += ARX[i].size();
-    }
-    for (muint i = 0; i < DWT.size(); i++) {
-      twt += DWT[i];
-    }
-    std::sprintf (str, "GRAPH %010lu WITH %lu SINKS AND %lu SOURCES", seed,
-                  DWT.size(), SWT.size());
-    f << str << std::endl;
-    if (equal (twt, std::floor (twt))) {
-      std::sprintf (str, " %lu ARCS AND %lu TOTAL WEIGHT", arc, muint (twt));
-    } else {
-      std::sprintf (str, " %lu ARCS AND %.8f TOTAL WEIGHT", arc, twt);
+bool ReadWarm (const char* fname, const mfvec& DWT, const mfvec& SWT,
+               objlist& T, mfvec& PR) {
+  mfloat AMT;                   // price or flow
+  muint  I, J;                  // node ids
+  Token  K[9];                  // tokens of the current line
+  muint  nt;                    // number of tokens on the current line
+  muint  off = DWT.size() + 1;  // first supply index
+  bool good = false;
+  T.clear ();
+  PR.clear ();
+  MFile f (fname);
+  if (f.Good()) {
+    const char* p = f.Data();
+    const char* e = p + f.Size();
+    if ((Tokens (p, e, K, 9) == 1) && (Match (K[0], "BEGIN"))) {
+      bool  cont = true;
+      muint pos  = 0;
+      while ((cont) && (p < e)) {
+        cont = false;
+        nt = Tokens (p, e, K, 9);
+        switch (pos) {
+          case 0:
+            if (   (nt == 8) && (Match (K[0], "WARM"))
+                && (Match (K[1], "START")) && (Match (K[2], "WITH"))
+                && (ScanUInt (K[3], I)) && (I == DWT.size())
+                && (Match (K[4], "SINKS")) && (Match (K[5], "AND"))
+                && (ScanUInt (K[6], J)) && (J == SWT.size())
+                && (Match (K[7], "SOURCES"))) {
+              cont = true;
+              pos = 1;
+            }
+            break;
+          case 1:
+            if ((nt == 1) && (Match (K[0], "PRICES"))) {
+              cont = true;
+              pos = 2;
+            }
+            break;
+          case 2:
+            if (nt == 1) {
+              if ((Match (K[0], "PLAN")) && (PR.size() == SWT.size())) {
+                cont = true;
+                pos = 3;
+              }
+            } else if (nt == 2) {
+              if (   (ScanUInt (K[0], J)) && (J == PR.size() + off)
+                  && (ScanFloat (K[1], AMT))) {
+                PR.push_back (AMT);
+                cont = true;
+              }
+            }
+            break;
+          case 3:
+            if (nt == 1) {
+              if (Match (K[0], "END")) {
+                good = true;
+              }
+            } else if (nt == 3) {
+              if (   (ScanUInt (K[0], I)) && (I > 0) && (I < off)
+                  && (ScanUInt (K[1], J)) && (J >= off)
+                  && (J < off + SWT.size()) && (ScanFloat (K[2], AMT))) {
+                T.emplace_back (AMT, mint (I - 1), mint (J - off));
+                cont = true;
+              }
+            }
+            break;
+          default:
+            break;
+        }
+      }
+    }
+  }
+  if (!good) {
+    T.clear ();
+    PR.clear ();
+  }
+  return good;
+}
+
+/** --- ScanArcs ---------------------------------------------------------------
+ * reads the ARCS section, which ends at the SUPPLY line; the arc lines are
+ * split at line boundaries into one chunk per thread, and every chunk is read
+ * twice: the first pass counts the arcs of every row, so that the second can
+ * place each arc directly at its final position in ARX; arcs keep their file
+ * order within each row, whatever the number of threads
+ **/
+bool ScanArcs (const char*& p, const char* e, const bool rev,
+               const muint NSINK, const muint NSORC, ArcSet& ARX) {
+  Token  T[5];  // tokens of the current line
+  muint  nr = (rev) ? NSORC : NSINK;  // number of rows of ARX
+  const char* s = p;  // first arc line
+  const char* q;      // first line after the arcs
+  // arc lines hold only numbers, so the first 'S' is on the SUPPLY line
+  q = static_cast <const char*> (std::memchr (s, 'S', muint (e - s)));
+  if (q == nullptr) {
+    return false;
+  }
+  while ((q > s) && (q[-1] != '\n')) {
+    --q;
+  }
+  p = q;
+  if ((Tokens (p, e, T, 5) != 1) || (!Match (T[0], "SUPPLY"))) {
+    return false;
+  }
+  muint nk = std::max (muint (1), std::min (gTHR, muint (q - s) >> 16));
+  std::vector <const char*> B (nk + 1, q);  // chunk boundaries
+  B[0] = s;
+  for (muint k = 1; k < nk; k++) {
+    const char* b = std::max (B[k-1], s + (muint (q - s) * k) / nk);
+    while ((b < q) && (b > s) && (b[-1] != '\n')) {
+      ++b;
     }
-    f << str << std::endl;
-    f << "DEMAND" << std::endl;
-    for (muint it = 0; it < DWT.size(); it++) {
-      if (equal (DWT[it], std::floor (DWT[it]))) {
-        std::sprintf (str, " %lu %lu", it + 1, muint (DWT[it]));
+    B[k] = b;
+  }
+  std::vector <muvec> CNT (nk, muvec (nr, 0));  // arcs of each row per chunk
+  std::vector <char>  OK (nk, 1);
+  Pool pool (nk);
+  pool.Run (nk, [&] (muint k) {
+    Token  U[5];
+    muint  IH, IT;
+    muvec& N = CNT[k];
+    const char* l = B[k];
+    while (l < B[k+1]) {
+      if (   (Tokens (l, B[k+1], U, 5) == 4)
+          && (ScanUInt (U[0], IT)) && (ScanUInt (U[1], IH))
+          && (IT > 0) && (IT <= NSINK)
+          && (IH > NSINK) && (IH <= NSINK + NSORC)) {
+        ++N[(rev) ? IH-NSINK-1 : IT-1];
       } else {
-        std::sprintf (str, " %lu %.8f", it + 1, DWT[it]);
+        OK[k] = 0;
+        return;
       }
-      f << str << std::endl;
     }
-    f << "ARCS" << std::endl;
-    for (muint it = 0; it < ARX.size(); it++) {
-      FL[it] = mfvec (ARX[it].size(), 0.0);
+  });
+  if (std::find (OK.begin(), OK.end(), 0) != OK.end()) {
+    return false;
+  }
+  // CNT[k][r] becomes the first position of chunk k within row r
+  muvec AO (nr + 1, 0);  // row offsets of ARX
+  for (muint r = 0; r < nr; r++) {
+    muint pos = AO[r];
+    for (muint k = 0; k < nk; k++) {
+      muint n = CNT[k][r];
+      CNT[k][r] = pos;
+      pos += n;
     }
-    for (muint it = 0; it < T.size(); it++) {
-      tst = 0;
-      while (   (tst < ARX[muint (T[it].i)].size())
-             && (ARX[muint (T[it].i)][tst].j != T[it].j)) {
-        tst++;
-      }
-      if (tst < ARX[muint (T[it].i)].size()) {
-        FL[muint (T[it].i)][tst] = T[it].c;
-      } else {
-        std::cout << "Overflow in flow calculation" << std::endl;
+    AO[r+1] = pos;
+  }
+  mxvec AL (AO.back());  // lot ids
+  mfvec AC (AO.back());  // costs
+  pool.Run (nk, [&] (muint k) {
+    Token  U[5];
+    mfloat CST;
+    muint  IH, IT, r;
+    muvec& P = CNT[k];
+    const char* l = B[k];
+    while (l < B[k+1]) {
+      Tokens (l, B[k+1], U, 5);
+      if (   (!ScanUInt (U[0], IT)) || (!ScanUInt (U[1], IH))
+          || (!ScanFloat (U[2], CST))) {
+        OK[k] = 0;
+        return;
       }
+      // FLW (U[3], solution flow) is UNUSED
+      r = (rev) ? IH-NSINK-1 : IT-1;
+      AL[P[r]]   = muidx ((rev) ? IT-1 : IH-NSINK-1);
+      AC[P[r]++] = CST;
     }
-    for (muint i = 0; i < ARX.size(); i++) {
-      for (muint j = 0; j < ARX[i].size(); j++) {
-        if (equal (ARX[i][j].c, std::floor (ARX[i][j].c))) {
-          if (equal (FL[i][j], std::floor (FL[i][j]))) {
-            std::sprintf (str, " %lu %lu %lu %lu",
-                          ARX[i][j].i + 1, muint (ARX[i][j].j) + DWT.size() + 1,
-                          muint (ARX[i][j].c), muint (FL[i][j]));
-          } else {
-            std::sprintf (str, " %lu %lu %lu %.8f",
-                          ARX[i][j].i + 1, muint (ARX[i][j].j) + DWT.size() + 1,
-                          muint (ARX[i][j].c), FL[i][j]);
-          }
-        } else {
-          if (equal (FL[i][j], std::floor (FL[i][j]))) {
-            std::sprintf (str, " %lu %lu %.8f %lu", ARX[i][j].i + 1,
-                          muint (ARX[i][j].j) + DWT.size() + 1,
-                          ARX[i][j].c, muint (FL[i][j]));
-          } else {
-            std::sprintf (str, " %lu %lu %.8f %.8f", ARX[i][j].i + 1,
-              muint (ARX[i][j].j) + DWT.size() + 1, ARX[i][j].c, FL[i][j]);
-          }
-        }
-        f << str << std::endl;
+  });
+  if (std::find (OK.begin(), OK.end(), 0) != OK.end()) {
+    return false;
+  }
+  ARX = ArcSet (AO, AL, AC);
+  return true;
+}
+
+/** --- ScanFloat --------------------------------------------------------------
+ * decimal values with at most 15 significant digits and 22 fractional digits
+ * are converted exactly (one correctly rounded operation); anything else is
+ * handed to std::strtod
+ **/
+bool ScanFloat (const Token& t, mfloat& v) {
+  static const mfloat P10[23] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+  const char* c = t.s;
+  const char* e = t.s + t.n;
+  bool  neg = false;
+  muint m   = 0;  // decimal mantissa
+  muint nd  = 0;  // significant digits in m
+  muint nf  = 0;  // digits after the decimal point
+  bool  dig = false;
+  if ((c < e) && ((*c == '-') || (*c == '+'))) {
+    neg = (*c == '-');
+    ++c;
+  }
+  while ((c < e) && (*c >= '0') && (*c <= '9')) {
+    dig = true;
+    m = 10 * m + muint (*c - '0');
+    if (m > 0) {
+      ++nd;
+    }
+    ++c;
+  }
+  if ((c < e) && (*c == '.')) {
+    ++c;
+    while ((c < e) && (*c >= '0') && (*c <= '9')) {
+      dig = true;
+      m = 10 * m + muint (*c - '0');
+      if (m > 0) {
+        ++nd;
       }
+      ++nf;
+      ++c;
     }
-    f << "SUPPLY" << std::endl;
-    for (muint it = 0; it < SWT.size(); it++) {
-      if (equal (SWT[it], std::floor (SWT[it]))) {
-        std::sprintf (str, " %lu %lu", it + DWT.size() + 1, muint (SWT[it]));
-      } else {
-        std::sprintf (str, " %lu %.8f", it + DWT.size() + 1, SWT[it]);
+  }
+  if ((c == e) && (dig) && (nd <= 15) && (nf <= 22)) {
+    v = mfloat (m) / P10[nf];
+    if (neg) {
+      v = -v;
+    }
+    return true;
+  }
+  char  buf[64];
+  char* end;
+  if ((t.n == 0) || (t.n >= sizeof (buf))) {
+    return false;
+  }
+  std::memcpy (buf, t.s, t.n);
+  buf[t.n] = '\0';
+  v = std::strtod (buf, &end);
+  return (end != buf);
+}
+
+/** --- ScanUInt ---------------------------------------------------------------
+ **/
+bool ScanUInt (const Token& t, muint& v) {
+  if ((t.n == 0) || (t.n > 19)) {
+    return false;
+  }
+  v = 0;
+  for (muint it = 0; it < t.n; it++) {
+    if ((t.s[it] < '0') || (t.s[it] > '9')) {
+      return false;
+    }
+    v = 10 * v + muint (t.s[it] - '0');
+  }
+  return true;
+}
+
+/** --- Tokens -----------------------------------------------------------------
+ * splits the line starting at p into blank-separated tokens, storing at most
+ * mx of them in T; p is moved to the start of the next line and the total
+ * number of tokens on the line is returned
+ **/
+muint Tokens (const char*& p, const char* e, Token* T, const muint mx) {
+  muint nt = 0;
+  while ((p < e) && (*p != '\n')) {
+    if ((*p == ' ') || (*p == '\t') || (*p == '\r')) {
+      ++p;
+    } else {
+      const char* s = p;
+      while (   (p < e) && (*p != '\n') && (*p != ' ') && (*p != '\t')
+             && (*p != '\r')) {
+        ++p;
       }
-      f << str << std::endl;
+      if (nt < mx) {
+        T[nt].s = s;
+        T[nt].n = muint (p - s);
+      }
+      ++nt;
+    }
+  }
+  if (p < e) {
+    ++p;
+  }
+  return nt;
+}
+
+/** --- WriteBinary ------------------------------------------------------------
+ **/
+int WriteBinary (const char* fname, const muint seed, const mfvec& DWT,
+                 const mfvec& SWT, const ArcSet& ARX) {
+  int err = 1;
+  GBinHead H;
+  std::memset (&H, 0, sizeof (GBinHead));
+  std::memcpy (H.magic, GBIN_MAGIC, sizeof (GBIN_MAGIC));
+  H.version = GBIN_VERSION;
+  H.order   = GBIN_ORDER;
+  H.seed    = seed;
+  H.nrow    = DWT.size();
+  H.ncol    = SWT.size();
+  H.narc    = ARX.Arcs();
+  std::ofstream f (fname, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (f.is_open()) {
+    f.write (reinterpret_cast <const char*> (&H), sizeof (GBinHead));
+    f.write (reinterpret_cast <const char*> (DWT.data()),
+             std::streamsize (H.nrow * sizeof (mfloat)));
+    f.write (reinterpret_cast <const char*> (SWT.data()),
+             std::streamsize (H.ncol * sizeof (mfloat)));
+    f.write (reinterpret_cast <const char*> (ARX.Offsets()),
+             std::streamsize ((H.nrow + 1) * sizeof (muint)));
+    f.write (reinterpret_cast <const char*> (ARX.Costs()),
+             std::streamsize (H.narc * sizeof (mfloat)));
+    f.write (reinterpret_cast <const char*> (ARX.Lots()),
+             std::streamsize (H.narc * sizeof (muidx)));
+    if (f.good()) {
+      err = 0;
     }
-    f << "END" << std::endl;
     f.close();
   }
   return err;
 }
 
+/** --- WriteFile --------------------------------------------------------------
+ * the file is formatted into large buffers, which a background thread writes
+ **/
+int WriteFile (const char* fname, const muint seed, const mfvec& DWT,
+               const mfvec& SWT, const ArcSet& ARX, const ArcIndex& AIX,
+               const objlist& T) {
+  mfloat twt = 0.0;
+  muint  tst;
+  char   str[255];
+  mfvec  FL (ARX.Arcs(), 0.0);  // flow on each arc
+  muint  off = DWT.size() + 1;  // first supply index
+  BufOut f (fname);
+  if (!f.Good()) {
+    return 1;
+  }
+  f.Put ("BEGIN\n");
+  for (muint i = 0; i < DWT.size(); i++) {
+    twt += DWT[i];
+  }
+  std::sprintf (str, "GRAPH %010lu WITH %lu SINKS AND %lu SOURCES\n", seed,
+                DWT.size(), SWT.size());
+  f.Put (str);
+  f.Put (' ');
+  f.UInt (ARX.Arcs());
+  f.Put (" ARCS AND ");
+  f.Num (twt);
+  f.Put (" TOTAL WEIGHT\nDEMAND\n");
+  for (muint it = 0; it < DWT.size(); it++) {
+    f.Put (' ');
+    f.UInt (it + 1);
+    f.Put (' ');
+    f.Num (DWT[it]);
+    f.Put ('\n');
+  }
+  f.Put ("ARCS\n");
+  for (muint it = 0; it < T.size(); it++) {
+    tst = AIX.Find (muint (T[it].i), muidx (T[it].j));
+    if (tst < AIX.Arcs()) {
+      FL[tst] = T[it].c;
+    } else {
+      std::cout << "Overflow in flow calculation" << std::endl;
+    }
+  }
+  for (muint i = 0; i < ARX.Size(); i++) {
+    for (muint k = ARX.Begin (i); k < ARX.End (i); k++) {
+      f.Put (' ');
+      f.UInt (i + 1);
+      f.Put (' ');
+      f.UInt (muint (ARX.Lot (k)) + off);
+      f.Put (' ');
+      f.Num (ARX.Cost (k));
+      f.Put (' ');
+      f.Num (FL[k]);
+      f.Put ('\n');
+    }
+  }
+  f.Put ("SUPPLY\n");
+  for (muint it = 0; it < SWT.size(); it++) {
+    f.Put (' ');
+    f.UInt (it + off);
+    f.Put (' ');
+    f.Num (SWT[it]);
+    f.Put ('\n');
+  }
+  f.Put ("END\n");
+  return f.Close ();
+}
+
+/** --- WriteWarm --------------------------------------------------------------
+ * saves the prices and plan of a solve, numbered as in the graph file, with
+ * every digit needed to read the same values back
+ **/
+int WriteWarm (const char* fname, const mfvec& DWT, const mfvec& SWT,
+               const objlist& T, const mfvec& PR) {
+  char   str[255];
+  muint  off = DWT.size() + 1;  // first supply index
+  BufOut f (fname);
+  if (!f.Good()) {
+    return 1;
+  }
+  f.Put ("BEGIN\n");
+  std::sprintf (str, "WARM START WITH %lu SINKS AND %lu SOURCES\nPRICES\n",
+                DWT.size(), SWT.size());
+  f.Put (str);
+  // the assignment auctions return a longer PR, with the lot prices first
+  for (muint it = 0; (it < SWT.size()) && (it < PR.size()); it++) {
+    std::sprintf (str, " %lu %.17g\n", it + off, PR[it]);
+    f.Put (str);
+  }
+  f.Put ("PLAN\n");
+  for (muint it = 0; it < T.size(); it++) {
+    if ((T[it].i > -1) && (T[it].c > 0.0)) {
+      std::sprintf (str, " %lu %lu %.17g\n", muint (T[it].i) + 1,
+                    muint (T[it].j) + off, T[it].c);
+      f.Put (str);
+    }
+  }
+  f.Put ("END\n");
+  return f.Close ();
+}
+
 /// ----------------------------------------------------------------------------
@@ -0,0 +1,64 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#include <fcntl.h>      // open, O_RDONLY
+#include <sys/mman.h>   // madvise, mmap, munmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+#include "mfile.hpp"
+
+/** --- Standard Constructor ---------------------------------------------------
+ * maps the whole file read-only; Good() is false if the file cannot be opened,
+ * is empty, or cannot be mapped
+ **/
+MFile::MFile (const char* fname) : pDAT (nullptr), pSZ (0) {
+  int fd = open (fname, O_RDONLY);
+  if (fd != -1) {
+    struct stat st;
+    if ((fstat (fd, &st) == 0) && (st.st_size > 0)) {
+      void* m = mmap (nullptr, size_t (st.st_size), PROT_READ, MAP_PRIVATE,
+                      fd, 0);
+      if (m != MAP_FAILED) {
+        madvise (m, size_t (st.st_size), MADV_SEQUENTIAL);
+        pDAT = static_cast <const char*> (m);
+        pSZ  = muint (st.st_size);
+      }
+    }
+    close (fd);
+  }
+}
+
+/** --- Destructor -------------------------------------------------------------
+ **/
+MFile::~MFile() {
+  if (pDAT != nullptr) {
+    munmap (const_cast <char*> (pDAT), size_t (pSZ));
+  }
+}
+
+/// ----------------------------------------------------------------------------
@@ -0,0 +1,142 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#include "pool.hpp"
+
+/** --- Standard Constructor ---------------------------------------------------
+ * starts n-1 workers; the thread calling Run is the n-th
+ **/
+Pool::Pool (const muint n)
+  : pJOB (nullptr), pGEN (0), pLEFT (0), pN (0), pNXT (0), pSTOP (false) {
+  for (muint it = 1; it < n; it++) {
+    pWRK.emplace_back (&Pool::Work, this);
+  }
+}
+
+/** --- Destructor -------------------------------------------------------------
+ **/
+Pool::~Pool() {
+  {
+    std::lock_guard <std::mutex> lk (pMTX);
+    pSTOP = true;
+  }
+  pCV.notify_all ();
+  for (auto& w : pWRK) {
+    w.join ();
+  }
+}
+
+/** --- Run --------------------------------------------------------------------
+ **/
+void Pool::Run (const muint n, const std::function <void (muint)>& f) {
+  if ((pWRK.empty()) || (n < 2)) {
+    for (muint it = 0; it < n; it++) {
+      f (it);
+    }
+    return;
+  }
+  {
+    std::lock_guard <std::mutex> lk (pMTX);
+    pJOB  = &f;
+    pN    = n;
+    pNXT  = 0;
+    pLEFT = n;
+    ++pGEN;
+  }
+  pCV.notify_all ();
+  Take ();
+  std::unique_lock <std::mutex> lk (pMTX);
+  pDONE.wait (lk, [this] { return (pLEFT == 0); });
+  pJOB = nullptr;
+}
+
+/** --- Split ------------------------------------------------------------------
+ * about four ranges per thread
+ **/
+void Pool::Split (const muvec& S,
+                  const std::function <void (muint, muint)>& f,
+                  const muint m) {
+  const muint n = S.size() - 1;
+  if (n == 0) {
+    return;
+  }
+  muint nb = std::min (n, 4 * Size());
+  if ((nb < 2) || (S[n] < m)) {
+    f (0, n);
+    return;
+  }
+  muvec B (nb + 1, n);
+  B[0] = 0;
+  for (muint k = 1; k < nb; k++) {
+    B[k] = muint (std::lower_bound (S.begin(), S.end(), S[n] / nb * k)
+                  - S.begin());
+  }
+  Run (nb, [&B, &f](const muint k) {
+    if (B[k] < B[k + 1]) {
+      f (B[k], B[k + 1]);
+    }
+  });
+  return;
+}
+
+/** --- Take -------------------------------------------------------------------
+ * runs calls of the current job until none are left to hand out
+ **/
+void Pool::Take () {
+  std::unique_lock <std::mutex> lk (pMTX);
+  while (pNXT < pN) {
+    muint it = pNXT++;
+    const std::function <void (muint)>* f = pJOB;
+    lk.unlock ();
+    (*f) (it);
+    lk.lock ();
+    if (--pLEFT == 0) {
+      pDONE.notify_one ();
+    }
+  }
+}
+
+/** --- Work -------------------------------------------------------------------
+ * worker loop: waits for a new job, helps with it, and waits again
+ **/
+void Pool::Work () {
+  muint gen = 0;
+  while (true) {
+    {
+      std::unique_lock <std::mutex> lk (pMTX);
+      pCV.wait (lk, [this, gen] { return ((pSTOP) || (pGEN != gen)); });
+      if (pSTOP) {
+        return;
+      }
+      gen = pGEN;
+    }
+    Take ();
+  }
+}
+
+/// ----------------------------------------------------------------------------
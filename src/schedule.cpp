@@ -0,0 +1,128 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+#include "schedule.hpp"
+
+/** --- Halt -------------------------------------------------------------------
+ * marks a phase given up at the end of the time budget, and reports it when
+ * verbose; Cut() tells the caller
+ **/
+void Schedule::Halt() {
+  pCUT = true;
+  if (gVBS > 0) {
+    char str[255];
+    std::sprintf (str, "  - Time budget spent       : plan of phase %lu", pPH);
+    std::cout << str << std::endl;
+  }
+  return;
+}
+
+/** --- More -------------------------------------------------------------------
+ * no schedule goes on once the gap tolerance gGAP is met or the time budget
+ * is spent; the adaptive schedule also stops once the gap between the dual
+ * and primal costs is below pWT * pMN * pSTP, which is what the fixed
+ * schedule certifies in its last phase
+ **/
+bool Schedule::More (const mfloat ep) {
+  bool mr = ((ep >= pMN) && (!pHIT));
+  if (pADP) {
+    mr = ((mr) && (!(pDC - pPC <= pWT * pMN * pSTP)));
+  }
+  if ((mr) && (Late())) {
+    Halt ();
+    mr = false;
+  }
+  return mr;
+}
+
+/** --- Next -------------------------------------------------------------------
+ * the adaptive step is pSTP, squared after a phase that did little (fewer
+ * bids than bidders, or prices that rose by less than one epsilon on average)
+ * and replaced by its square root after a phase that took more than twice the
+ * bids of the one before; epsilon never exceeds the mean slack (dual less
+ * primal cost, per unit of weight) left by the last phase, and never falls
+ * below pMN * pSTP, where the fixed schedule ends
+ **/
+mfloat Schedule::Next (const mfloat ep) const {
+  mfloat nx = ep * pSTP;
+  if ((pADP) && (pPH > 0)) {
+    if ((pNB < pNBD) || (pRS < 1.0)) {
+      nx = ep * pSTP * pSTP;
+    } else if ((pPH > 1) && (pNB > 2 * pNBP)) {
+      nx = ep * std::sqrt (pSTP);
+    }
+    if ((pDC - pPC) / pWT < nx) {
+      nx = (pDC - pPC) / pWT;
+    }
+    if (nx < pMN * pSTP) {
+      nx = pMN * pSTP;
+    }
+  }
+  return nx;
+}
+
+/** --- Phase ------------------------------------------------------------------
+ * records a finished phase: epsilon ep, nb bids by nbd bidders, a mean price
+ * rise of rs epsilons, and the primal and dual costs pc and dc it left
+ **/
+void Schedule::Phase (const mfloat ep, const muint nb, const muint nbd,
+                      const mfloat rs, const mfloat pc, const mfloat dc) {
+  pDC  = dc;
+  pNBP = pNB;
+  pNB  = nb;
+  pNBD = nbd;
+  pPC  = pc;
+  pPH += 1;
+  pRS  = rs;
+  pHIT = ((gGAP > 0.0) && (dc - pc <= gGAP * std::abs (pc)));
+  char str[255];
+  if (gVBS > 1) {
+    std::sprintf (str, "  - phase %2lu : eps %e, %lu bids, gap %e, rise %.2f",
+                  pPH, ep, nb, dc - pc, rs);
+    std::cout << str << std::endl;
+  }
+  if ((pHIT) && (ep >= pMN)) {
+    std::sprintf (str, "  - Gap tolerance met       : phase %lu, "
+                  "relative gap %e", pPH, (dc - pc) / std::abs (pc));
+    std::cout << str << std::endl;
+  }
+  return;
+}
+
+/** --- Renew ------------------------------------------------------------------
+ * starts a new time budget of gTME seconds, for a re-solve
+ **/
+void Schedule::Renew() {
+  pCUT = false;
+  pEND = std::chrono::steady_clock::now() +
+         std::chrono::duration_cast <std::chrono::steady_clock::duration>
+           (std::chrono::duration <mfloat> (gTME));
+  return;
+}
+
+/// ----------------------------------------------------------------------------
@@ -27,6 +27,34 @@ Science Foundation.
 ---------------------------------------------------------------------------- **/
 
 #include "sopbid.hpp"
+#include "bidscan.hpp"  // BidScan, ScanUnits
+
+/** --- Standard Constructor ---------------------------------------------------
+ * the bidder reads row inid of A; lot j of A stands for the unit lots
+ * U[j] <= u < U[j+1]
+ **/
+SOPbid::SOPbid (const muint inid, const muint wt, const ArcSet& A,
+                const muvec& U)
+  : pCRWT (0), pCST (A.Costs() + A.Begin (inid)), pEPS (1.0), pID (inid),
+    pLOT (A.Lots() + A.Begin (inid)), pMXWT (wt), pNA (A.Degree (inid)),
+    pNU (0), pUNT (U.data())
+{
+  for (muint k = 0; k < pNA; k++) {
+    pNU += pUNT[pLOT[k] + 1] - pUNT[pLOT[k]];
+  }
+}
+
+/** --- Best -------------------------------------------------------------------
+ * best net value (cost less price) over the unit lots of the arcs
+ **/
+mfloat SOPbid::Best (const objlist& PR) const {
+  if (pNU > 1) {
+    BidScan S;
+    ScanUnits (pCST, pLOT, pUNT, pNA, PR, S);
+    return S.v1;
+  }
+  return pCST[0] - PR[pUNT[pLOT[0]]].c;
+}
 
 /** --- MakeBid ----------------------------------------------------------------
  **/
@@ -35,22 +63,22 @@ void SOPbid::MakeBid (const objlist& PR, objlist& D) {
   if (ct > 0) {
     mfloat W;
     objlist Mo, Mn;
-    Mo.reserve(pARC.size());
-    Mn.reserve(pARC.size());
     bool bc = true;
     mint id = -1;
-    for (muint it = 0; it < pARC.size(); it++) {
-      if (mint (pID) == PR[muint (pARC[it].j)].i) {
-        Mo.emplace_back(pARC[it].c, pARC[it].i, pARC[it].j);
-        if (bc) {
-          if (id == -1) {
-            id = Mo.back().i;
-          } else if (id != Mo.back().i) {
-            bc = false;
+    for (muint it = 0; it < pNA; it++) {
+      for (muint u = pUNT[pLOT[it]]; u < pUNT[pLOT[it] + 1]; u++) {
+        if (mint (pID) == PR[u].i) {
+          Mo.emplace_back(pCST[it], pLOT[it], u);
+          if (bc) {
+            if (id == -1) {
+              id = Mo.back().i;
+            } else if (id != Mo.back().i) {
+              bc = false;
+            }
           }
+        } else {
+          Mn.emplace_back(pCST[it] - PR[u].c, pLOT[it], u);
         }
-      } else {
-        Mn.emplace_back(pARC[it].c - PR[muint (pARC[it].j)].c, pARC[it].i, pARC[it].j);
       }
     }
     if (ct >= Mn.size()) {
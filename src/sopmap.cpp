@@ -30,9 +30,12 @@ Science Foundation.
 
 /** --- Standard Constructor ---------------------------------------------------
  **/
-SOPmap::SOPmap (const mfvec& DWT, const mfvec& SWT, const voblist& A,
+SOPmap::SOPmap (const mfvec& DWT, const mfvec& SWT, const ArcSet& A,
                 const mfloat MX, const mfloat MN, const mfloat ST)
-  : pEPS (MX), pGCD (1), pMN (MN), pSTP (ST)
+  : pEPS (MX), pGCD (1), pNB (0), pPOL (std::make_shared <Pool> (gTHR)),
+    pPS (0.0),
+    pSCH (MN, ST, std::accumulate (DWT.begin(), DWT.end(), mfloat (0.0))),
+    pSNE (MX)
 {
   pBDR.clear();
   pBID.clear();
@@ -77,18 +80,14 @@ SOPmap::SOPmap (const mfvec& DWT, const mfvec& SWT, const voblist& A,
           pPR.emplace_back (0.0, -1, it);
         }
       }
+      pCHG = mbvec (pPR.size(), false);
+      pSLK = mfvec (pPR.size(), 0.0);
+      pARC = A;
+      pAIX = ArcIndex (pARC);
+      pUNT.swap (pos);
       pBDR.reserve (DWT.size());
-      objlist tA;
       for (muint it = 0; it < DWT.size(); it++) {
-        tA.clear();
-        for (muint m = 0; m < A[it].size(); m++) {
-          for (muint n = 0;
-               n < muint (SWT[muint (A[it][m].j)]) / muint (pGCD); n++) {
-            tA.emplace_back (A[it][m].c, A[it][m].j,
-                             pos[muint (A[it][m].j)] + n);
-          }
-        }
-        pBDR.emplace_back (it, muint (DWT[it]) / muint (pGCD), tA);
+        pBDR.emplace_back (it, muint (DWT[it]) / muint (pGCD), pARC, pUNT);
         pBDR.back().Refresh (pEPS);
         pBID.emplace_back (objlist (muint (DWT[it]) / muint (pGCD),
                                     Object(0.0, -1, -1)));
@@ -141,15 +140,19 @@ void SOPmap::Solve (objlist& T, mfvec& PR) {
  **/
 void SOPmap::Auction() {
   do {
-    pEPS *= pSTP;
+    pEPS = pSCH.Next (pEPS);
+    const muint nb = pNB;
     for (muint it = 0; it < pBDR.size(); it++) {
       pBDR[it].Refresh (pEPS);
     }
-    for (auto it = pPR.begin(); it < pPR.end(); it++) {
-      it->i = -1;
+    Retain();
+    if (!Round()) {
+      pSCH.Halt ();
+      Restore ();
+      break;
     }
-    Round();
-  } while (pEPS >= pMN);
+    Measure (pNB - nb);
+  } while (pSCH.More (pEPS));
   return;
 }
 
@@ -159,36 +162,148 @@ mint SOPmap::gcd (const mint a, const mint b) const {
   return (b == 0) ? a : gcd (b, a % b);
 }
 
+/** --- Measure ----------------------------------------------------------------
+ * ends a phase: finds the best net value of every bidder and the slack (best
+ * net value less net value) of each unit lot held, and reports the phase, with
+ * its primal and dual costs, to pSCH; the slack is measured against the best
+ * net value over all unit lots of the bidder, a test at least as strict as
+ * eps-complementary slackness
+ **/
+void SOPmap::Measure (const muint nb) {
+  mfvec bs (pBDR.size(), 0.0);
+  muvec ld (pBDR.size() + 1, 0);
+  for (muint n = 0; n < pBDR.size(); n++) {
+    ld[n + 1] = ld[n] + pBDR[n].Load();
+  }
+  pPOL->Split (ld, [this, &bs](const muint b, const muint e) {
+    for (muint n = b; n < e; n++) {
+      bs[n] = pBDR[n].Best (pPR);
+    }
+  });
+  mfloat pc = 0.0;
+  mfloat dc = 0.0;
+  mfloat ps = 0.0;
+  for (muint u = 0; u < pPR.size(); u++) {
+    ps += pPR[u].c;
+    if (pPR[u].i != -1) {
+      const muint n = muint (pPR[u].i);
+      pSLK[u] = bs[n] - Net (n, u);
+      dc += bs[n] + pPR[u].c;
+      pc += bs[n] - pSLK[u] + pPR[u].c;
+    }
+  }
+  pSCH.Phase (pEPS, nb, pBDR.size(), (ps - pPS) / (mfloat (pPR.size()) * pEPS),
+              pc * mfloat (pGCD), dc * mfloat (pGCD));
+  pPS = ps;
+  if (pSCH.Timed()) {
+    pSNE = pEPS;
+    pSNP = pPR;
+  }
+  return;
+}
+
+/** --- Net --------------------------------------------------------------------
+ * net value of unit lot u to bidder n, or -gINF if no arc of the bidder leads
+ * to the lot of u
+ **/
+mfloat SOPmap::Net (const muint n, const muint u) const {
+  const muint k = pAIX.Find (n, muidx (pPR[u].j));
+  return (k == pAIX.Arcs()) ? -gINF : pARC.Cost (k) - pPR[u].c;
+}
+
+/** --- Restore ----------------------------------------------------------------
+ * goes back to the end of the last phase when a phase was given up: the
+ * prices and holders kept by Measure return, with the epsilon of that phase,
+ * and every bidder counts the unit lots it holds again
+ **/
+void SOPmap::Restore() {
+  pPR  = pSNP;
+  pEPS = pSNE;
+  for (muint it = 0; it < pBDR.size(); it++) {
+    pBDR[it].Refresh (pEPS);
+  }
+  for (muint u = 0; u < pPR.size(); u++) {
+    if (pPR[u].i != -1) {
+      pBDR[muint (pPR[u].i)].Push();
+    }
+  }
+  return;
+}
+
+/** --- Retain -----------------------------------------------------------------
+ * starts a phase from the assignment of the last one: a bidder keeps each unit
+ * lot while the slack of the lot is within pEPS, and loses the rest
+ **/
+void SOPmap::Retain() {
+  for (muint u = 0; u < pPR.size(); u++) {
+    if (pPR[u].i != -1) {
+      if (pSLK[u] > pEPS) {
+        pPR[u].i = -1;
+      } else {
+        pBDR[muint (pPR[u].i)].Push();
+      }
+    }
+  }
+  return;
+}
+
 /** --- Round ------------------------------------------------------------------
+ * only the bidders in pACT bid; a bidder that is not active can only become
+ * active again by losing a lot, and then joins pACT for the next iteration;
+ * false if the phase was given up at the end of the time budget
  **/
-void SOPmap::Round() {
-  bool avail = true;
-  muint n;
-  while (avail) {
-    // get new bids
-    for (muint it = 0; it < pBDR.size(); it++) {
-      pBDR[it].MakeBid (pPR, pBID[it]);
+bool SOPmap::Round() {
+  pACT.clear();
+  for (muint it = 0; it < pBDR.size(); it++) {
+    if (pBDR[it].Active()) {
+      pACT.push_back (it);
+    }
+  }
+  while (!pACT.empty()) {
+    if (pSCH.Late()) {
+      return false;
     }
+    const muint na = pACT.size();
+    pNB += na;
+    // get new bids, split over the threads by the work of each bid
+    muvec ld (na + 1, 0);
+    for (muint n = 0; n < na; n++) {
+      ld[n + 1] = ld[n] + pBDR[pACT[n]].Load();
+    }
+    pPOL->Split (ld, [this](const muint b, const muint e) {
+      for (muint n = b; n < e; n++) {
+        pBDR[pACT[n]].MakeBid (pPR, pBID[pACT[n]]);
+      }
+    });
     // select winners from bids
-    UpdateClaims();
-    avail = false;
-    n = pBDR.size();
-    while ((!avail) && (n > 0)) { avail = pBDR[--n].Active(); }
+    UpdateClaims (na);
+    // keep the bidders that are still active, in order
+    std::sort (pACT.begin() + mint (na), pACT.end());
+    std::inplace_merge (pACT.begin(), pACT.begin() + mint (na), pACT.end());
+    pACT.erase (std::unique (pACT.begin(), pACT.end()), pACT.end());
+    pACT.erase (std::remove_if (pACT.begin(), pACT.end(),
+      [this](const muint b) -> bool { return !pBDR[b].Active(); }),
+      pACT.end());
   }
-  return;
+  return true;
 }
 
 /** --- UpdateClaims -----------------------------------------------------------
+ * takes the bids of the first na bidders of pACT; outbid bidders are added to
+ * pACT
  **/
-void SOPmap::UpdateClaims() {
-  std::vector <bool> ch (pPR.size(), false);
-  for (muint it = 0; it < pBID.size(); it++) {
+void SOPmap::UpdateClaims (const muint na) {
+  muvec ch;
+  for (muint n = 0; n < na; n++) {
+    const muint it = pACT[n];
     for (auto ob = pBID[it].begin(); ob < pBID[it].end(); ob++) {
       if (pPR[muint (ob->j)] < *ob) {
-        if (!ch[muint (ob->j)]) {
-          ch[muint (ob->j)] = true;
+        if (!pCHG[muint (ob->j)]) {
+          pCHG[muint (ob->j)] = true;
+          ch.push_back (muint (ob->j));
           if (pPR[muint (ob->j)].i != -1) {
             pBDR[muint (pPR[muint (ob->j)].i)].Pop();
+            pACT.push_back (muint (pPR[muint (ob->j)].i));
           }
         }
         pPR[muint (ob->j)].c = ob->c;
@@ -198,9 +313,8 @@ void SOPmap::UpdateClaims() {
   }
   // apply results to bidders
   for (muint k = 0; k < ch.size(); k++) {
-    if (ch[k]) {
-      pBDR[muint (pPR[k].i)].Push();
-    }
+    pCHG[ch[k]] = false;
+    pBDR[muint (pPR[ch[k]].i)].Push();
   }
   return;
 }
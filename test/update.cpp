@@ -0,0 +1,262 @@
+/** ----------------------------------------------------------------------------
+Copyright (C) 2016 Joseph D Walsh III <math@jdwalsh03.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, see <http://www.gnu.org/licenses/>.
+
+This file is part of the "AUCTION ALGORITHMS IN C++" software project. See the
+document <filelist.txt> for a full list of the project files. If
+<filelist.txt> or any other file is missing, go to <http://www.jdwalsh03.com/>
+to download the complete project.
+
+This material is based upon work supported by the National Science Foundation
+Graduate Research Fellowship under Grant No. DGE-1148903. Any opinion,
+findings, and conclusions or recommendations expressed in this material are
+those of the author and do not necessarily reflect the views of the National
+Science Foundation.
+---------------------------------------------------------------------------- **/
+
+// Test of GAmap::Update. A random complete graph is solved, then its costs,
+// demands, and supplies are edited in batches, and each batch is re-solved
+// with Update. Without a time budget, every Update must give a feasible plan
+// whose cost matches a new solve of the edited graph. With a time budget,
+// Solve and Update may stop early: a plan they return must still be feasible,
+// an Update that returns false must leave the last plan as it was, and
+// calling Update again must go on from there and complete the re-solve.
+
+#include <algorithm>   // std::max
+#include <cmath>       // std::abs
+#include <iostream>    // std::cout, std::endl, std::sprintf
+#include <limits>      // std::numeric_limits
+#include <random>      // std::mt19937_64
+#include "glob.hpp"    // mfloat, mfvec, mint, muint
+#include "object.hpp"  // Object, objlist, voblist
+#include "arcset.hpp"  // ArcSet
+#include "gamap.hpp"   // GAmap
+
+bool   gADP = false;
+bool   gASY = false;
+mfloat gEPS = std::sqrt(std::numeric_limits<mfloat>::epsilon());
+mfloat gGAP = 0.0;
+mfloat gINF = std::numeric_limits<mfloat>::infinity();
+muint  gTHR = 1;
+mfloat gTME = 0.0;
+muint  gVBS = 0;
+
+struct Graph {
+  mfvec   DWT;  // demand of each bidder
+  mfvec   SWT;  // supply of each lot
+  voblist A;    // arcs of each bidder (c the cost, j the lot)
+};
+
+mfloat Cost (const Graph& G, const objlist& T);
+bool   Feasible (const Graph& G, const objlist& T);
+void   Edit (std::mt19937_64& r, Graph& G, GAmap& M);
+Graph  Make (const muint n, const muint seed);
+bool   Run (const muint n, const muint seed, const mfloat tm);
+bool   Same (const objlist& T1, const mfvec& P1, const objlist& T2,
+             const mfvec& P2);
+
+/** --- main -------------------------------------------------------------------
+ **/
+int main () {
+  bool ok = true;
+  ok = (Run (200, 1, 0.0)) && (ok);
+  ok = (Run (200, 2, 0.0)) && (ok);
+  const mfloat TM[] = { 2e-4, 1e-3, 1e-2 };
+  for (const mfloat tm : TM) {
+    ok = (Run (400, 1, tm)) && (ok);
+    ok = (Run (400, 3, tm)) && (ok);
+  }
+  std::cout << ((ok) ? "  UPDATE TEST PASSED" : "  UPDATE TEST FAILED")
+            << std::endl;
+  return (ok) ? 0 : 1;
+}
+
+/** --- Cost -------------------------------------------------------------------
+ * cost of plan T on the arcs of G
+ **/
+mfloat Cost (const Graph& G, const objlist& T) {
+  mfloat c = 0.0;
+  for (const Object& O : T) {
+    if (O.i > -1) {
+      for (const Object& E : G.A[muint (O.i)]) {
+        if (E.j == O.j) {
+          c += O.c * E.c;
+        }
+      }
+    }
+  }
+  return c;
+}
+
+/** --- Edit -------------------------------------------------------------------
+ * changes the costs of 20 random arcs, and moves one unit of demand and one
+ * unit of supply, in G and in M
+ **/
+void Edit (std::mt19937_64& r, Graph& G, GAmap& M) {
+  const muint n = G.DWT.size();
+  for (muint e = 0; e < 20; e++) {
+    const muint i = r() % n;
+    Object& E = G.A[i][r() % G.A[i].size()];
+    E.c = std::max (mfloat (1.0), E.c + mfloat (mint (r() % 7) - 3));
+    M.SetCost (i, muint (E.j), E.c);
+  }
+  const muint i1 = r() % n;
+  const muint i2 = r() % n;
+  const muint j1 = r() % n;
+  const muint j2 = r() % n;
+  if ((G.DWT[i1] > 1.0) && (G.SWT[j1] > 1.0)) {
+    G.DWT[i1] -= 1.0;
+    G.DWT[i2] += 1.0;
+    G.SWT[j1] -= 1.0;
+    G.SWT[j2] += 1.0;
+    M.SetDemand (i1, G.DWT[i1]);
+    M.SetDemand (i2, G.DWT[i2]);
+    M.SetSupply (j1, G.SWT[j1]);
+    M.SetSupply (j2, G.SWT[j2]);
+  }
+  return;
+}
+
+/** --- Feasible ---------------------------------------------------------------
+ * true if plan T meets every demand and supply of G
+ **/
+bool Feasible (const Graph& G, const objlist& T) {
+  mfvec dw (G.DWT.size(), 0.0);
+  mfvec sw (G.SWT.size(), 0.0);
+  for (const Object& O : T) {
+    if (O.i > -1) {
+      dw[muint (O.i)] += O.c;
+      sw[muint (O.j)] += O.c;
+    }
+  }
+  for (muint i = 0; i < dw.size(); i++) {
+    if (!equal (dw[i], G.DWT[i])) {
+      return false;
+    }
+  }
+  for (muint j = 0; j < sw.size(); j++) {
+    if (!equal (sw[j], G.SWT[j])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** --- Make -------------------------------------------------------------------
+ * complete n x n graph with costs 1 to 100 and weights 1 to 9; the supplies
+ * add up to the demands
+ **/
+Graph Make (const muint n, const muint seed) {
+  std::mt19937_64 r (seed);
+  Graph G;
+  G.DWT = mfvec (n, 0.0);
+  G.SWT = mfvec (n, 1.0);
+  G.A   = voblist (n);
+  muint wt = 0;
+  for (muint i = 0; i < n; i++) {
+    G.DWT[i] = mfloat (1 + r() % 9);
+    wt += muint (G.DWT[i]);
+  }
+  for (muint k = n; k < wt; k++) {
+    G.SWT[r() % n] += 1.0;
+  }
+  for (muint i = 0; i < n; i++) {
+    for (muint j = 0; j < n; j++) {
+      G.A[i].emplace_back (mfloat (1 + r() % 100), mint (i), mint (j));
+    }
+  }
+  return G;
+}
+
+/** --- Run --------------------------------------------------------------------
+ * solves an n x n graph, then re-solves six batches of edits with Update,
+ * with a time budget of tm seconds (0: none); Update is called until it
+ * completes, at most 10000 times per batch, whatever the speed of the machine;
+ * false on a failed check
+ **/
+bool Run (const muint n, const muint seed, const mfloat tm) {
+  Graph G = Make (n, seed);
+  const mfloat mx = 100.0 / 5.0;
+  const mfloat mn = 1.0 / mfloat (n);
+  mfloat wt = 0.0;
+  for (const mfloat w : G.DWT) {
+    wt += w;
+  }
+  gTME = tm;
+  GAmap M (G.DWT, G.SWT, ArcSet (G.A), mx, mn, 0.25);
+  objlist T;
+  mfvec PR;
+  bool ok = true;
+  muint nu = 0;  // calls of Update
+  if (((!M.Solve (T, PR)) && (tm == 0.0)) || (!Feasible (G, T))) {
+    ok = false;
+  }
+  std::mt19937_64 r (seed + 100);
+  for (muint b = 0; b < 6; b++) {
+    Edit (r, G, M);
+    bool dn = false;
+    for (muint k = 0; (k < 10000) && (!dn); k++) {
+      const objlist T0 = T;
+      const mfvec   P0 = PR;
+      ++nu;
+      dn = M.Update (T, PR);
+      if ((!dn) && (!Same (T, PR, T0, P0))) {
+        ok = false;
+      }
+    }
+    if (!dn) {
+      ok = false;
+    } else {
+      if (!Feasible (G, T)) {
+        ok = false;
+      }
+      if (tm == 0.0) {
+        GAmap F (G.DWT, G.SWT, ArcSet (G.A), mx, mn, 0.25);
+        objlist TF;
+        mfvec PF;
+        F.Solve (TF, PF);
+        if (std::abs (Cost (G, T) - Cost (G, TF)) > wt * mn) {
+          ok = false;
+        }
+      }
+    }
+  }
+  gTME = 0.0;
+  char str[255];
+  std::sprintf (str, "  - %4lu x %-4lu seed %lu, budget %.1e sec : "
+                "6 batches in %lu calls of Update, %s", n, n, seed, tm, nu,
+                (ok) ? "ok" : "FAILED");
+  std::cout << str << std::endl;
+  return ok;
+}
+
+/** --- Same -------------------------------------------------------------------
+ * true if the plans and prices are identical
+ **/
+bool Same (const objlist& T1, const mfvec& P1, const objlist& T2,
+           const mfvec& P2) {
+  if ((T1.size() != T2.size()) || (P1 != P2)) {
+    return false;
+  }
+  for (muint k = 0; k < T1.size(); k++) {
+    if ((T1[k].c != T2[k].c) || (T1[k].i != T2[k].i) ||
+        (T1[k].j != T2[k].j)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// ----------------------------------------------------------------------------